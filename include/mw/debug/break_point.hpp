@@ -19,6 +19,7 @@
 #include <mw/debug/frame.hpp>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <iostream>
 
 namespace mw {
@@ -95,6 +96,55 @@ public:
 
 };
 
+/** This class is used to implement a trace point, i.e. a breakpoint that does not stop the target.
+ * The debugger prints the arguments with the format each time the location is passed and the output is passed to trace,
+ * while the target keeps running. Since there's no stop, invoke is never called.
+ *
+ * \par Example
+ *
+ * \code{.cpp}
+ * struct trace_write : mw::debug::trace_point
+ * {
+ *     trace_write() : trace_point("write", "fd=%d len=%d", {"fd", "len"}) {}
+ *     void trace(const std::string & text) override
+ *     {
+ *         std::cout << "write " << text << std::endl;
+ *     }
+ * };
+ * \endcode
+ */
+class trace_point : public break_point
+{
+    std::string _format;
+    std::vector<std::string> _arguments;
+public:
+    /**Construct the trace point from a function identifier.
+     *
+     * @param func_name The Identifier.
+     * @param format A printf format, it is escaped by the runner, so it's passed as it should be printed.
+     * @param arguments The expressions printed by the format.
+     */
+    trace_point(const std::string & func_name, const std::string & format, const std::vector<std::string> & arguments)
+            : break_point(func_name), _format(format), _arguments(arguments) {}
+    ///Construct a trace point from a location in source-code.
+    trace_point(const std::string & file_name, std::size_t line, const std::string & format, const std::vector<std::string> & arguments)
+            : break_point(file_name, line), _format(format), _arguments(arguments) {}
+
+    ///The format the arguments are printed with.
+    const std::string & format() const {return _format;}
+    ///The expressions, that are printed.
+    const std::vector<std::string> & arguments() const {return _arguments;}
+
+    /**This function is called with the formatted output, each time the location is passed.
+     * It is called while the target is running, so it must not access the debugger.
+     *
+     * @param text The output of the format, without the trailing newline.
+     */
+    virtual void trace(const std::string & text) = 0;
+
+    void invoke(frame &, const std::string &, int) override {}
+};
+
 
 
 
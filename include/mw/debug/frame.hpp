@@ -16,7 +16,10 @@
 #ifndef MW_GDB_FRAME_HPP_
 #define MW_GDB_FRAME_HPP_
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <functional>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -82,6 +85,13 @@ struct address_info
     boost::optional<std::uint64_t> offset; ///<The offset in the containing function, if available.
 };
 
+///A range of target memory.
+struct memory_range
+{
+    std::uint64_t addr; ///<The first address of the range
+    std::uint64_t size; ///<The size of the range in bytes
+};
+
 /** This class represents a stackframe.
  * A stackframe let's you examine the stack in gdb. A reference to the frame will be passed to the break-point implementation on invocation.
  *
@@ -92,15 +102,23 @@ struct frame
 {
     ///Get the id of the current frame
     const std::string & id() const {return _id;}
-    ///Get the already read argument list. This means it does not need to be read again.
-    const std::vector<arg> &arg_list() const {return _arg_list;}
-    /** This function is for convenience and let's the user access elements in the argument list.
+    /** Get the argument list, as read when the breakpoint was hit.
+     * The arguments are decoded on first access, so this decodes all of them; use arg_list(index) if only some are needed.
+     */
+    const std::vector<arg> &arg_list() const
+    {
+        for (std::size_t idx = 0u; idx < _arg_list.size(); idx++)
+            _resolve_arg(idx);
+        return _arg_list;
+    }
+    /** This function is for convenience and let's the user access elements in the argument list. Only this argument is decoded.
      *  @param index The index for the element.
      *  @overload const std::vector<arg> &arg_list() const
      */
     const arg &arg_list(std::size_t index) const
     {
         try {
+            _resolve_arg(index);
             return _arg_list.at(index);
         }
         catch(std::out_of_range & o)
@@ -117,14 +135,17 @@ struct frame
      */
     virtual boost::optional<address_info> addr2line(std::uint64_t addr) const = 0;
     /** This function returns the cstring of the argument requested, if it is a null-terminated string.
-     * This will take care of the possible ellipsis of passed cstrings.
+     * This will take care of the possible ellipsis of passed cstrings, by reading the rest from the target memory.
+     * The string is cut at cstring_max_length().
      *
      * @param index Position of the argument the cstring shall be obtained from.
      */
     inline std::string get_cstring(std::size_t index);
+    ///The maximum length of a string returned by get_cstring.
+    std::size_t cstring_max_length() const {return _cstring_max_length;}
     ///Returns the map of the registers and their values.
     virtual std::unordered_map<std::string, std::uint64_t> regs() = 0;
-    ///Set a variable in the current frame
+    ///Set a variable in the current frame. The assignment is deferred until it could be observed, so errors might be reported by a later call.
     virtual void set(const std::string &var, const std::string & val)   = 0;
     ///Set a member of an array in the current frame
     virtual void set(const std::string &var, std::size_t idx, const std::string & val) = 0;
@@ -137,7 +158,7 @@ struct frame
      * @return The printed value
      */
     virtual var print(const std::string & id, bool bitwise = false) = 0;
-    /** Return from the current function.
+    /** Return from the current function. The arguments not accessed yet are decoded before, so arg_list stays valid afterwards.
      *
      * @param value The return value, needs to be passed if the return is not void.
      */
@@ -196,9 +217,34 @@ struct frame
     virtual void disable(const break_point & bp) = 0;
     ///Reenable a breakpoint
     virtual void enable(const break_point & bp) = 0;
-    ///Read a chunk of memory
+    /** Read a chunk of memory.
+     * @return The memory, which is shorter than size if only the beginning of the chunk is readable.
+     * @throws interpreter_error If the memory at addr is not readable.
+     */
     virtual std::vector<std::uint8_t> read_memory(std::uint64_t addr, std::size_t size) = 0;
-    ///Write a chunk of memory
+    /** Read a region of memory, that might not fit into memory. The sink is called with consecutive chunks in address order.
+     * @return The number of bytes read, which is less than size if the region is not completely readable.
+     */
+    virtual std::uint64_t read_memory(std::uint64_t addr, std::uint64_t size,
+                                      const std::function<void(std::uint64_t addr, const std::uint8_t * data, std::size_t size)> & sink) = 0;
+    /** Dump a region of memory into a file. The file is mapped into memory and the region is streamed into it chunk by chunk.
+     * @param sparse If set, pages that are all zero are not written, so they can stay holes in the file.
+     * @return The number of bytes dumped, the file is cut to that size if the region is not completely readable.
+     */
+    virtual std::uint64_t dump_memory(std::uint64_t addr, std::uint64_t size, const std::string & file, bool sparse = true) = 0;
+    /** Watch a region of memory, so the bytes that changed between two stops can be obtained by changed_memory.
+     * The region stays watched for the rest of the run, its current content is the reference for the first call of changed_memory.
+     */
+    virtual void watch_memory(std::uint64_t addr, std::uint64_t size) = 0;
+    ///Stop watching the region starting at addr.
+    virtual void unwatch_memory(std::uint64_t addr) = 0;
+    /** Get the ranges of the watched region starting at addr, that changed since the last call or since it's watched.
+     * @return The changed ranges in address order, empty if the region is not watched.
+     */
+    virtual std::vector<memory_range> changed_memory(std::uint64_t addr) = 0;
+    /** Write a chunk of memory. Like set, the write is deferred until it can be observed, i.e. by a read or when the target continues.
+     * If one of the deferred writes fails, the later ones are still done and the call that flushed them throws.
+     */
     virtual void write_memory(std::uint64_t addr, const std::vector<std::uint8_t> &vec) = 0;
 protected:
 #if !defined(MW_GDB_DOXYGEN)
@@ -208,8 +254,11 @@ protected:
 
     }
     virtual ~frame() = default;
+    ///Decode the argument at index if that's not done yet, the index might be out of range.
+    virtual void _resolve_arg(std::size_t) const {}
     std::string _id;
-    std::vector<arg> _arg_list;
+    mutable std::vector<arg> _arg_list;
+    std::size_t _cstring_max_length = 64u * 1024u;
 #endif
 };
 
@@ -219,11 +268,52 @@ std::string frame::get_cstring(std::size_t index)
 
     if (!entry.cstring.ellipsis)
         return entry.cstring.value;
-    //has ellipsis, so I'll need to get the rest manually
-    auto val = entry.cstring.value;
+    //has ellipsis, so I'll need to get the rest manually. The value is the address, so the string is read in growing blocks.
+    std::uint64_t addr = 0u;
+    try
+    {
+        addr = std::stoull(entry.value, nullptr, 16);
+    }
+    catch (std::logic_error &)
+    {
+    }
+
+    std::string val;
+    std::size_t block = 256u;
+    while ((addr != 0u) && (val.size() < _cstring_max_length))
+    {
+        auto size = (std::min)(block, _cstring_max_length - val.size());
+        std::vector<std::uint8_t> data;
+        try
+        {
+            data = read_memory(addr + val.size(), size);
+        }
+        catch (std::exception &)
+        {
+        }
+
+        if (data.empty())
+            break;
+
+        auto begin = reinterpret_cast<const char*>(data.data());
+        auto end   = static_cast<const char*>(std::memchr(begin, '\0', data.size()));
+        if (end != nullptr)
+            return val.append(begin, end);
+
+        val.append(data.begin(), data.end());
+        if (data.size() < size) //the rest is not readable
+            return val;
+        block *= 2u;
+    }
+
+    if (!val.empty())
+        return val;
+
+    //the memory is not accessible, so it's read char by char.
+    val = entry.cstring.value;
     auto idx = val.size();
 
-    while(true)
+    while(val.size() < _cstring_max_length)
     {
         auto p = print(entry.id + '[' + std::to_string(idx++) + ']');
         auto i = std::stoi(p.value);
@@ -0,0 +1,220 @@
+/**
+ * @file   mw/gdb/arg_cache.hpp
+ * @date   16.10.2026
+ * @author Klemens D. Morgenstern
+ *
+ * Published under [Apache License 2.0](http://www.apache.org/licenses/LICENSE-2.0.html)
+  <pre>
+    /  /|  (  )   |  |  /
+   /| / |   \/    | /| /
+  / |/  |   /\    |/ |/
+ /  /   |  (  \   /  |
+               )
+ </pre>
+ */
+#ifndef MW_GDB_ARG_CACHE_HPP_
+#define MW_GDB_ARG_CACHE_HPP_
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mw
+{
+namespace gdb
+{
+
+///The argument names of the breakpoint locations, so they're only queried once per location.
+/** The cache can be stored in a file, which is only used by a later run if the key, i.e. the build-id, size and modification time of the executable, matches.
+ */
+class arg_cache
+{
+    std::unordered_map<std::uint64_t, std::vector<std::string>> _names;
+    bool _modified = false;
+
+    constexpr static const char * _header = "mw-dbg-runner arg-cache 1";
+
+    //read an unsigned value of the given size from the file, in the byte order of the elf file.
+    static bool _read(std::istream & is, std::uint64_t pos, std::size_t size, bool big_endian, std::uint64_t & value)
+    {
+        unsigned char buf[8];
+        if (!is.seekg(static_cast<std::streamoff>(pos)) || !is.read(reinterpret_cast<char*>(buf), size))
+            return false;
+        value = 0u;
+        for (std::size_t i = 0u; i < size; i++)
+            value |= static_cast<std::uint64_t>(buf[big_endian ? i : size - 1 - i]) << (8 * (size - 1 - i));
+        return true;
+    }
+public:
+    ///The gnu build-id of an elf file in hex, empty if it has none.
+    static std::string build_id(const boost::filesystem::path & exe)
+    {
+        boost::filesystem::ifstream is{exe, std::ios::binary};
+        char ident[6];
+        if (!is.read(ident, sizeof(ident)) || (std::string(ident, 4) != "\x7f" "ELF"))
+            return {};
+
+        const bool is64       = ident[4] == 2;
+        const bool big_endian = ident[5] == 2;
+        const std::size_t word = is64 ? 8u : 4u;
+
+        std::uint64_t shoff, shentsize, shnum;
+        if (!_read(is, is64 ? 40u : 32u, word, big_endian, shoff) ||
+            !_read(is, is64 ? 58u : 46u, 2u,   big_endian, shentsize) ||
+            !_read(is, is64 ? 60u : 48u, 2u,   big_endian, shnum))
+            return {};
+
+        for (std::uint64_t idx = 0u; idx < shnum; idx++)
+        {
+            auto sh = shoff + idx * shentsize;
+            std::uint64_t type, offset, size;
+            if (!_read(is, sh + 4u, 4u, big_endian, type))
+                return {};
+            if (type != 7u) //SHT_NOTE
+                continue;
+            if (!_read(is, sh + (is64 ? 24u : 16u), word, big_endian, offset) ||
+                !_read(is, sh + (is64 ? 32u : 20u), word, big_endian, size))
+                return {};
+
+            //the notes are name size, desc size, type, then name & desc padded to 4 bytes.
+            for (std::uint64_t pos = offset; pos + 12u <= offset + size; )
+            {
+                std::uint64_t namesz, descsz, note_type;
+                if (!_read(is, pos,      4u, big_endian, namesz) ||
+                    !_read(is, pos + 4u, 4u, big_endian, descsz) ||
+                    !_read(is, pos + 8u, 4u, big_endian, note_type))
+                    return {};
+
+                auto name_pos = pos + 12u;
+                auto desc_pos = name_pos + ((namesz + 3u) & ~std::uint64_t(3u));
+                pos = desc_pos + ((descsz + 3u) & ~std::uint64_t(3u));
+
+                std::string name(static_cast<std::size_t>(namesz), '\0');
+                if ((note_type != 3u) || (namesz != 4u) || (descsz > 64u) || //NT_GNU_BUILD_ID
+                    !is.seekg(static_cast<std::streamoff>(name_pos)) || !is.read(&name[0], namesz) || (name != std::string("GNU", 4)))
+                    continue;
+
+                std::string desc(static_cast<std::size_t>(descsz), '\0');
+                if (!is.seekg(static_cast<std::streamoff>(desc_pos)) || !is.read(&desc[0], descsz))
+                    return {};
+
+                std::string res;
+                for (auto c : desc)
+                {
+                    constexpr static char digits[] = "0123456789abcdef";
+                    res.push_back(digits[(static_cast<unsigned char>(c) >> 4) & 0x0F]);
+                    res.push_back(digits[ static_cast<unsigned char>(c)       & 0x0F]);
+                }
+                return res;
+            }
+        }
+        return {};
+    }
+
+    ///The key a stored cache is valid for, empty if the executable can't be found.
+    static std::string key(const boost::filesystem::path & exe)
+    {
+        boost::system::error_code ec;
+        auto size  = boost::filesystem::file_size(exe, ec);
+        if (ec)
+            return {};
+        auto mtime = boost::filesystem::last_write_time(exe, ec);
+        if (ec)
+            return {};
+
+        auto id = build_id(exe);
+        return (id.empty() ? std::string("-") : id) + ' ' + std::to_string(size) + ' ' + std::to_string(mtime);
+    }
+
+    ///The argument names of the location at addr, nullptr if not known.
+    const std::vector<std::string> * find(std::uint64_t addr) const
+    {
+        auto itr = _names.find(addr);
+        return itr == _names.end() ? nullptr : &itr->second;
+    }
+
+    void add(std::uint64_t addr, const std::vector<std::string> & names)
+    {
+        _names[addr] = names;
+        _modified = true;
+    }
+
+    ///True if locations were added since loading.
+    bool modified() const {return _modified;}
+
+    ///Load the cache from file, returns false if it doesn't exist or was stored for another key.
+    bool load(const boost::filesystem::path & file, const std::string & key)
+    {
+        boost::filesystem::ifstream is{file};
+        std::string header, key_line;
+        if (key.empty() || !std::getline(is, header) || (header != _header) ||
+            !std::getline(is, key_line) || (key_line != "key " + key))
+            return false;
+
+        std::string line;
+        while (std::getline(is, line))
+        {
+            std::istringstream ls{line};
+            std::uint64_t addr;
+            if (!(ls >> std::hex >> addr))
+                continue;
+
+            auto & names = _names[addr];
+            std::string name;
+            while (ls >> name)
+                names.push_back(name);
+        }
+        _modified = false;
+        return true;
+    }
+
+    ///Store the cache in file. It's written to a temporary file first, so the old cache is kept if that fails.
+    bool save(const boost::filesystem::path & file, const std::string & key)
+    {
+        if (key.empty())
+            return false;
+
+        auto tmp = file;
+        tmp += ".tmp";
+        {
+            boost::filesystem::ofstream os{tmp, std::ios::trunc};
+            if (!os)
+                return false;
+
+            os << _header << '\n' << "key " << key << '\n';
+            for (auto & entry : _names)
+            {
+                os << std::hex << entry.first << std::dec;
+                for (auto & name : entry.second)
+                    os << ' ' << name;
+                os << '\n';
+            }
+            if (!os.flush())
+            {
+                os.close();
+                boost::system::error_code ec;
+                boost::filesystem::remove(tmp, ec);
+                return false;
+            }
+        }
+
+        boost::system::error_code ec;
+        boost::filesystem::rename(tmp, file, ec);
+        if (ec)
+        {
+            boost::filesystem::remove(tmp, ec);
+            return false;
+        }
+        _modified = false;
+        return true;
+    }
+};
+
+}
+}
+
+#endif /* MW_GDB_ARG_CACHE_HPP_ */
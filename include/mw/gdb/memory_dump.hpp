@@ -0,0 +1,111 @@
+/**
+ * @file   mw/gdb/memory_dump.hpp
+ * @date   16.10.2026
+ * @author Klemens D. Morgenstern
+ *
+ * Published under [Apache License 2.0](http://www.apache.org/licenses/LICENSE-2.0.html)
+  <pre>
+    /  /|  (  )   |  |  /
+   /| / |   \/    | /| /
+  / |/  |   /\    |/ |/
+ /  /   |  (  \   /  |
+               )
+ </pre>
+ */
+#ifndef MW_GDB_MEMORY_DUMP_HPP_
+#define MW_GDB_MEMORY_DUMP_HPP_
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace mw
+{
+namespace gdb
+{
+
+///A region of target memory, that shall be dumped into a file.
+struct dump_region
+{
+    std::uint64_t addr;
+    std::uint64_t size;
+    std::string file;
+};
+
+///Output file of a memory dump, that is mapped into memory, so the chunks read from the target are copied straight into it.
+/** The file is created with the full size of the region. In sparse mode pages that are all zero are not written,
+ * so they stay holes if the file system supports it.
+ */
+class memory_dump
+{
+    boost::filesystem::path _path;
+    std::uint64_t _addr;
+    std::uint64_t _size;
+    bool _sparse;
+    boost::interprocess::file_mapping  _file;
+    boost::interprocess::mapped_region _region;
+
+    constexpr static std::size_t _page_size = 4096u;
+
+    static bool _is_zero(const std::uint8_t * data, std::size_t size)
+    {
+        return (size == 0u) || ((data[0] == 0u) && (std::memcmp(data, data + 1, size - 1) == 0));
+    }
+
+    static const boost::filesystem::path & _create(const boost::filesystem::path & path, std::uint64_t size)
+    {
+        boost::filesystem::ofstream fs{path, std::ios::binary | std::ios::trunc};
+        if (!fs)
+            BOOST_THROW_EXCEPTION(std::runtime_error("cannot create dump file " + path.string()));
+        fs.close();
+        boost::filesystem::resize_file(path, size);
+        return path;
+    }
+public:
+    memory_dump(const boost::filesystem::path & path, std::uint64_t addr, std::uint64_t size, bool sparse = true)
+        : _path(path), _addr(addr), _size(size), _sparse(sparse),
+          _file(_create(path, size).string().c_str(), boost::interprocess::read_write)
+    {
+        if (size != 0u)
+            _region = boost::interprocess::mapped_region(_file, boost::interprocess::read_write, 0, static_cast<std::size_t>(size));
+    }
+
+    ///Copy a chunk read from the target into the file. The chunk must be inside the region.
+    void write(std::uint64_t addr, const std::uint8_t * data, std::size_t size)
+    {
+        auto out = static_cast<std::uint8_t*>(_region.get_address()) + (addr - _addr);
+        if (!_sparse)
+        {
+            std::memcpy(out, data, size);
+            return;
+        }
+
+        const std::size_t page_size = _page_size;
+        for (std::size_t pos = 0u; pos < size; pos += page_size)
+        {
+            auto len = (std::min)(page_size, size - pos);
+            if (!_is_zero(data + pos, len))
+                std::memcpy(out + pos, data + pos, len);
+        }
+    }
+
+    ///Unmap the file and cut it to the given size, i.e. the amount that could actually be read.
+    void finish(std::uint64_t size)
+    {
+        _region = boost::interprocess::mapped_region();
+        if (size < _size)
+            boost::filesystem::resize_file(_path, size);
+    }
+};
+
+}
+}
+
+#endif /* MW_GDB_MEMORY_DUMP_HPP_ */
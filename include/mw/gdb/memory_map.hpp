@@ -0,0 +1,194 @@
+/**
+ * @file   mw/gdb/memory_map.hpp
+ * @date   16.10.2026
+ * @author Klemens D. Morgenstern
+ *
+ * Published under [Apache License 2.0](http://www.apache.org/licenses/LICENSE-2.0.html)
+  <pre>
+    /  /|  (  )   |  |  /
+   /| / |   \/    | /| /
+  / |/  |   /\    |/ |/
+ /  /   |  (  \   /  |
+               )
+ </pre>
+ */
+#ifndef MW_GDB_MEMORY_MAP_HPP_
+#define MW_GDB_MEMORY_MAP_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mw
+{
+namespace gdb
+{
+
+///The readable memory regions of the target. An empty map means that the memory map is unknown, so everything is considered readable.
+class memory_map
+{
+public:
+    struct region
+    {
+        std::uint64_t begin;
+        std::uint64_t end; //exclusive
+        bool cache; //false if the region must only be read as requested, e.g. peripherals.
+        bool exec;  //true if it holds code, which might contain breakpoints.
+    };
+private:
+    std::vector<region> _regions;
+
+    static bool _parse_hex(const std::string & st, std::uint64_t & value)
+    {
+        try
+        {
+            std::size_t pos = 0u;
+            value = std::stoull(st, &pos, 16);
+            return pos == st.size();
+        }
+        catch (std::logic_error &)
+        {
+            return false;
+        }
+    }
+public:
+    memory_map() = default;
+
+    ///Add a readable region, the regions must not overlap.
+    void add(std::uint64_t begin, std::uint64_t end, bool cache = true, bool exec = false)
+    {
+        if (begin >= end)
+            return;
+        region r{begin, end, cache, exec};
+        _regions.insert(std::upper_bound(_regions.begin(), _regions.end(), r,
+                            [](const region & lhs, const region & rhs){return lhs.begin < rhs.begin;}),
+                        r);
+    }
+
+    bool empty() const {return _regions.empty();}
+    const std::vector<region> & regions() const {return _regions;}
+
+    /** Split [addr, addr + size) at the region boundaries. Only the part, that is readable without a gap from addr is returned,
+     * i.e. the result is empty if addr is not mapped.
+     */
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> segments(std::uint64_t addr, std::uint64_t size) const
+    {
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> res;
+        if (_regions.empty())
+        {
+            res.emplace_back(addr, size);
+            return res;
+        }
+
+        auto end = (std::numeric_limits<std::uint64_t>::max() - addr) < size ? std::numeric_limits<std::uint64_t>::max() : addr + size;
+        auto itr = std::upper_bound(_regions.begin(), _regions.end(), addr,
+                        [](std::uint64_t val, const region & r){return val < r.begin;});
+        if (itr == _regions.begin())
+            return res;
+
+        auto pos = addr;
+        for (--itr; (itr != _regions.end()) && (pos < end) && (itr->begin <= pos) && (pos < itr->end); itr++)
+        {
+            auto seg_end = (std::min)(end, itr->end);
+            res.emplace_back(pos, seg_end - pos);
+            pos = seg_end;
+        }
+        return res;
+    }
+
+    ///The number of bytes readable from addr without a gap, at most size.
+    std::uint64_t readable(std::uint64_t addr, std::uint64_t size) const
+    {
+        std::uint64_t sz = 0u;
+        for (auto & seg : segments(addr, size))
+            sz += seg.second;
+        return sz;
+    }
+
+    ///Check if no region overlapping [addr, addr + size) is marked nocache.
+    bool cacheable(std::uint64_t addr, std::uint64_t size) const
+    {
+        auto end = (std::numeric_limits<std::uint64_t>::max() - addr) < size ? std::numeric_limits<std::uint64_t>::max() : addr + size;
+        return std::none_of(_regions.begin(), _regions.end(),
+                            [&](const region & r){return !r.cache && (r.begin < end) && (addr < r.end);});
+    }
+
+    ///Check if a region overlapping [addr, addr + size) is executable.
+    bool executable(std::uint64_t addr, std::uint64_t size) const
+    {
+        auto end = (std::numeric_limits<std::uint64_t>::max() - addr) < size ? std::numeric_limits<std::uint64_t>::max() : addr + size;
+        return std::any_of(_regions.begin(), _regions.end(),
+                           [&](const region & r){return r.exec && (r.begin < end) && (addr < r.end);});
+    }
+
+    /** Parse the output of gdb's `info mem`, e.g.
+     *
+     *     Num Enb Low Addr           High Addr          Attrs
+     *     0   y   0x00000000 0x00040000 ro nocache
+     */
+    static memory_map from_info_mem(const std::string & text)
+    {
+        memory_map mp;
+        std::istringstream is{text};
+        std::string line;
+        while (std::getline(is, line))
+        {
+            std::istringstream ls{line};
+            std::string num, enabled, low, high, attr;
+            if (!(ls >> num >> enabled >> low >> high) || (enabled != "y"))
+                continue;
+
+            std::uint64_t begin, end;
+            if (!_parse_hex(low, begin) || !_parse_hex(high, end))
+                continue;
+
+            bool readable = true;
+            bool cache    = true;
+            while (ls >> attr)
+                if (attr == "wo")
+                    readable = false;
+                else if (attr == "nocache")
+                    cache = false;
+
+            if (end == 0u) //the end of the address space
+                end = std::numeric_limits<std::uint64_t>::max();
+            if (readable)
+                mp.add(begin, end, cache);
+        }
+        return mp;
+    }
+
+    ///Parse /proc/<pid>/maps, e.g. `00400000-00452000 r-xp 00000000 08:02 173521 /usr/bin/dbus-daemon`
+    static memory_map from_proc_maps(std::istream & is)
+    {
+        memory_map mp;
+        std::string line;
+        while (std::getline(is, line))
+        {
+            auto dash  = line.find('-');
+            auto space = line.find(' ');
+            if ((dash == std::string::npos) || (space == std::string::npos) || (dash > space) || (space + 1 >= line.size()))
+                continue;
+
+            std::uint64_t begin, end;
+            if (!_parse_hex(line.substr(0, dash), begin) || !_parse_hex(line.substr(dash + 1, space - dash - 1), end))
+                continue;
+
+            //the permissions are e.g. "r-xp".
+            if (line[space + 1] == 'r')
+                mp.add(begin, end, true, (space + 3 < line.size()) && (line[space + 3] == 'x'));
+        }
+        return mp;
+    }
+};
+
+}
+}
+
+#endif /* MW_GDB_MEMORY_MAP_HPP_ */
@@ -0,0 +1,174 @@
+/**
+ * @file   mw/gdb/mi2/arena.hpp
+ * @date   16.10.2026
+ * @author Klemens D. Morgenstern
+ *
+ * Published under [Apache License 2.0](http://www.apache.org/licenses/LICENSE-2.0.html)
+  <pre>
+    /  /|  (  )   |  |  /
+   /| / |   \/    | /| /
+  / |/  |   /\    |/ |/
+ /  /   |  (  \   /  |
+               )
+ </pre>
+ */
+#ifndef MW_GDB_MI2_ARENA_HPP_
+#define MW_GDB_MI2_ARENA_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace mw
+{
+namespace gdb
+{
+namespace mi2
+{
+
+///A monotonic memory resource. Memory is not freed on deallocation, but all at once by reset.
+/** It is used to build the result tree of one output block. Blocks grow geometrically and the
+ * largest one is kept by reset, so a steady state needs no allocation for the nodes of the tree.
+ * The strings held by the values are still allocated on the free store.
+ */
+class arena
+{
+    struct block
+    {
+        block * next;
+        std::size_t size;
+    };
+
+    block * _head = nullptr;
+    char  * _pos  = nullptr;
+    char  * _end  = nullptr;
+    std::size_t _next_size;
+
+    static char * _data(block * b) {return reinterpret_cast<char*>(b) + sizeof(block);}
+
+    static char * _align(char * p, std::size_t align)
+    {
+        auto val = reinterpret_cast<std::uintptr_t>(p);
+        return p + ((align - (val % align)) % align);
+    }
+
+    char * _grow(std::size_t size, std::size_t align)
+    {
+        auto needed = size + align + sizeof(block);
+        auto bs = (std::max)(_next_size, needed);
+        auto b = static_cast<block*>(::operator new(bs));
+        b->next = _head;
+        b->size = bs;
+        _head = b;
+        _pos  = _data(b);
+        _end  = reinterpret_cast<char*>(b) + bs;
+        _next_size = bs * 2;
+        return _align(_pos, align);
+    }
+public:
+    ///Construct the arena, the first block will have the passed size.
+    explicit arena(std::size_t initial_size = 4096u) : _next_size(initial_size) {}
+    arena(const arena &) = delete;
+    arena & operator=(const arena &) = delete;
+
+    ~arena()
+    {
+        while (_head)
+        {
+            auto nx = _head->next;
+            ::operator delete(_head);
+            _head = nx;
+        }
+    }
+
+    ///Allocate memory, which stays valid until the next reset.
+    void * allocate(std::size_t size, std::size_t align = alignof(std::max_align_t))
+    {
+        auto p = _pos ? _align(_pos, align) : nullptr;
+        if (!p || (size > static_cast<std::size_t>(_end - p)))
+            p = _grow(size, align);
+        _pos = p + size;
+        return p;
+    }
+
+    ///Release all memory allocated from the arena. Only the last & largest block is kept.
+    void reset()
+    {
+        if (!_head)
+            return;
+
+        while (_head->next)
+        {
+            auto nx = _head->next->next;
+            ::operator delete(_head->next);
+            _head->next = nx;
+        }
+        _pos = _data(_head);
+        _end = reinterpret_cast<char*>(_head) + _head->size;
+    }
+
+    ///The amount of memory held by the arena.
+    std::size_t capacity() const
+    {
+        std::size_t sz = 0u;
+        for (auto b = _head; b != nullptr; b = b->next)
+            sz += b->size;
+        return sz;
+    }
+};
+
+///Allocator using an arena, or the free store if none is set.
+/** Copies of a container don't inherit the arena, so data can be copied out of a parse result
+ * without being tied to its lifetime. Moves do keep it, so a moved container must not outlive the arena.
+ */
+template<typename T>
+struct arena_allocator
+{
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    template<typename U>
+    struct rebind { using other = arena_allocator<U>; };
+
+    arena_allocator() noexcept = default;
+    arena_allocator(arena * resource) noexcept : _resource(resource) {}
+    template<typename U>
+    arena_allocator(const arena_allocator<U> & rhs) noexcept : _resource(rhs.resource()) {}
+
+    T * allocate(std::size_t n)
+    {
+        if (_resource)
+            return static_cast<T*>(_resource->allocate(n * sizeof(T), alignof(T)));
+        else
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T * p, std::size_t) noexcept
+    {
+        if (!_resource)
+            ::operator delete(p);
+    }
+
+    arena_allocator select_on_container_copy_construction() const { return arena_allocator(); }
+
+    ///The arena used, nullptr if the free store is used.
+    arena * resource() const noexcept {return _resource;}
+private:
+    arena * _resource = nullptr;
+};
+
+template<typename T, typename U>
+bool operator==(const arena_allocator<T> & lhs, const arena_allocator<U> & rhs) {return lhs.resource() == rhs.resource();}
+
+template<typename T, typename U>
+bool operator!=(const arena_allocator<T> & lhs, const arena_allocator<U> & rhs) {return lhs.resource() != rhs.resource();}
+
+}
+}
+}
+
+#endif /* MW_GDB_MI2_ARENA_HPP_ */
@@ -40,7 +40,7 @@ class async_record_handler_t
                 {
                     if (!sink.empty())
                         if (ao.class_ == id)
-                            parse_result<T>(ao.results);
+                            sink(parse_result<T>(ao.results));
                 });
     }
 
@@ -66,10 +66,10 @@ class async_record_handler_t
     boost::signals2::scoped_connection _conn_thread_selected = _make_adapter(_sig_thread_selected, "thread-selected");
 
     boost::signals2::signal<void(const library_loaded &)> _sig_library_loaded;
-    boost::signals2::scoped_connection _conn_library_loaded    = _make_adapter(_sig_library_loaded, "thread-loaded");
+    boost::signals2::scoped_connection _conn_library_loaded    = _make_adapter(_sig_library_loaded, "library-loaded");
 
     boost::signals2::signal<void(const library_loaded &)> _sig_library_unloaded;
-    boost::signals2::scoped_connection _conn_library_unloaded   = _make_adapter(_sig_library_unloaded, "thread-unloaded");
+    boost::signals2::scoped_connection _conn_library_unloaded   = _make_adapter(_sig_library_unloaded, "library-unloaded");
 
     boost::signals2::signal<void(const traceframe_changed &)> _sig_traceframe_changed;
     boost::signals2::scoped_connection _conn_traceframe_changed = _make_adapter(_sig_traceframe_changed, "traceframe-changed");
@@ -0,0 +1,205 @@
+/**
+ * @file   mw/gdb/mi2/cstring.hpp
+ * @date   16.10.2026
+ * @author Klemens D. Morgenstern
+ *
+ * Published under [Apache License 2.0](http://www.apache.org/licenses/LICENSE-2.0.html)
+  <pre>
+    /  /|  (  )   |  |  /
+   /| / |   \/    | /| /
+  / |/  |   /\    |/ |/
+ /  /   |  (  \   /  |
+               )
+ </pre>
+ */
+#ifndef MW_GDB_MI2_CSTRING_HPP_
+#define MW_GDB_MI2_CSTRING_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MW_GDB_MI2_CSTRING_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define MW_GDB_MI2_CSTRING_SSE2 1
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace mw
+{
+namespace gdb
+{
+namespace mi2
+{
+namespace detail
+{
+
+inline unsigned count_trailing_zeros(std::uint32_t mask)
+{
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward(&idx, mask);
+    return static_cast<unsigned>(idx);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+///Find the first '"' or '\\' in [begin, end), returns end if there is none.
+inline const char * find_quote_or_escape(const char * begin, const char * end)
+{
+    auto p = begin;
+#if defined(MW_GDB_MI2_CSTRING_AVX2)
+    const auto quote  = _mm256_set1_epi8('"');
+    const auto escape = _mm256_set1_epi8('\\');
+    while ((end - p) >= 32)
+    {
+        auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        auto hits  = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, escape));
+        auto mask  = static_cast<std::uint32_t>(_mm256_movemask_epi8(hits));
+        if (mask != 0u)
+            return p + count_trailing_zeros(mask);
+        p += 32;
+    }
+#endif
+#if defined(MW_GDB_MI2_CSTRING_AVX2) || defined(MW_GDB_MI2_CSTRING_SSE2)
+    const auto quote16  = _mm_set1_epi8('"');
+    const auto escape16 = _mm_set1_epi8('\\');
+    while ((end - p) >= 16)
+    {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        auto hits  = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote16), _mm_cmpeq_epi8(chunk, escape16));
+        auto mask  = static_cast<std::uint32_t>(_mm_movemask_epi8(hits));
+        if (mask != 0u)
+            return p + count_trailing_zeros(mask);
+        p += 16;
+    }
+#endif
+    for (; p != end; p++)
+        if ((*p == '"') || (*p == '\\'))
+            return p;
+    return end;
+}
+
+inline bool is_octal(char c) {return (c >= '0') && (c <= '7');}
+
+}
+
+///Find the closing quote of a c-string. The range starts behind the opening quote.
+/** Escaped characters are skipped, so the returned pointer is the first unescaped '"' or end if the string is not terminated.
+ */
+inline const char * scan_cstring(const char * begin, const char * end)
+{
+    auto p = begin;
+    while ((p = detail::find_quote_or_escape(p, end)) != end)
+    {
+        if (*p == '"')
+            return p;
+        //an escape, skip the escaped character.
+        if ((end - p) < 2)
+            return end;
+        p += 2;
+    }
+    return end;
+}
+
+///Unescape the content of a c-string, i.e. the range between the quotes, into out.
+/** This handles the escapes gdb emits, i.e. the single characters escapes of C, '\\e' and octal values.
+ * Unknown escapes yield the escaped character.
+ */
+inline void unescape_cstring(const char * begin, const char * end, std::string & out)
+{
+    out.clear();
+    out.reserve(end - begin);
+
+    auto p = begin;
+    while (p != end)
+    {
+        auto esc = detail::find_quote_or_escape(p, end);
+        out.append(p, esc);
+        if (esc == end)
+            break;
+
+        p = esc + 1;
+        if (*esc == '"') //not escaped, which cannot happen in a scanned c-string.
+        {
+            out.push_back('"');
+            continue;
+        }
+
+        if (p == end) //dangling backslash, keep it.
+        {
+            out.push_back('\\');
+            break;
+        }
+
+        char c = *p++;
+        switch (c)
+        {
+        case 'n': out.push_back('\n');   break;
+        case 't': out.push_back('\t');   break;
+        case 'r': out.push_back('\r');   break;
+        case 'a': out.push_back('\a');   break;
+        case 'b': out.push_back('\b');   break;
+        case 'f': out.push_back('\f');   break;
+        case 'v': out.push_back('\v');   break;
+        case 'e': out.push_back('\033'); break;
+        case '0': case '1': case '2': case '3':
+        case '4': case '5': case '6': case '7':
+        {
+            int val = c - '0';
+            for (int i = 1; (i < 3) && (p != end) && detail::is_octal(*p); i++)
+                val = (val * 8) + (*p++ - '0');
+            out.push_back(static_cast<char>(val));
+            break;
+        }
+        default: out.push_back(c); break; //'\\', '"', '\'' and unknown escapes
+        }
+    }
+}
+
+///Quote str as a c-string, so it can be passed as one argument of a command.
+/** Quotes, backslashes and control characters are escaped, the latter as octal values if C has no single character escape.
+ */
+inline std::string escape_cstring(const std::string & str)
+{
+    std::string out;
+    out.reserve(str.size() + 2u);
+    out.push_back('"');
+    for (auto c : str)
+    {
+        switch (c)
+        {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n";  break;
+        case '\t': out += "\\t";  break;
+        case '\r': out += "\\r";  break;
+        default:
+            if ((static_cast<unsigned char>(c) < 0x20u) || (c == '\x7f'))
+            {
+                auto val = static_cast<unsigned char>(c);
+                out.push_back('\\');
+                out.push_back(static_cast<char>('0' + ((val >> 6) & 7)));
+                out.push_back(static_cast<char>('0' + ((val >> 3) & 7)));
+                out.push_back(static_cast<char>('0' +  (val       & 7)));
+            }
+            else
+                out.push_back(c);
+        }
+    }
+    out.push_back('"');
+    return out;
+}
+
+}
+}
+}
+
+#endif /* MW_GDB_MI2_CSTRING_HPP_ */
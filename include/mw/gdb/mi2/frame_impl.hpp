@@ -16,6 +16,7 @@
 #define MW_GDB_DETAIL_FRAME_IMPL_HPP_
 
 #include <mw/gdb/process.hpp>
+#include <mw/gdb/mi2/page_cache.hpp>
 
 namespace mw { namespace gdb { namespace mi2 {
 
@@ -34,9 +35,12 @@ struct frame_impl : mw::debug::frame
                std::vector<mw::debug::arg> && args,
                process & proc,
                mi2::interpreter & interpreter,
-               std::ostream & log_)
-            : mw::debug::frame(std::move(id), std::move(args)), proc(proc), _interpreter(interpreter), _log(log_)
+               std::ostream & log_,
+               std::vector<boost::optional<std::string>> && raw_args = {})
+            : mw::debug::frame(std::move(id), std::move(args)), proc(proc), _interpreter(interpreter), _log(log_),
+              _cache(proc.memory_page_size(), proc.memory_read_ahead()), _raw_args(std::move(raw_args))
     {
+        _cstring_max_length = proc.cstring_max_length();
     }
     void set_exit(int code) override;
     void select(int frame) override;
@@ -50,16 +54,58 @@ struct frame_impl : mw::debug::frame
     void enable (const mw::debug::break_point & bp) override;
 
     std::vector<std::uint8_t> read_memory(std::uint64_t addr, std::size_t size) override;
+    std::uint64_t read_memory(std::uint64_t addr, std::uint64_t size,
+                              const std::function<void(std::uint64_t, const std::uint8_t *, std::size_t)> & sink) override;
     void write_memory(std::uint64_t addr, const std::vector<std::uint8_t> &vec) override;
+    std::uint64_t dump_memory(std::uint64_t addr, std::uint64_t size, const std::string & file, bool sparse = true) override;
+    void watch_memory(std::uint64_t addr, std::uint64_t size) override;
+    void unwatch_memory(std::uint64_t addr) override;
+    std::vector<mw::debug::memory_range> changed_memory(std::uint64_t addr) override;
 
 
     std::ostream & log() override { return _log; }
 
-    mw::debug::interpreter & interpreter() override {return _interpreter; }
+    //direct access to the interpreter could observe pending writes.
+    mw::debug::interpreter & interpreter() override {flush(); return _interpreter; }
+
+    ///Execute the pending writes, must be called before the target continues.
+    void flush();
 
     process & proc;
     mw::gdb::mi2::interpreter & _interpreter;
     std::ostream & _log;
+protected:
+    void _resolve_arg(std::size_t index) const override;
+private:
+    //the frame only lives during one stop, so the cache only needs to be dropped when the target modifies memory.
+    page_cache _cache;
+
+    //the values of the arguments as given by the stop record, they're decoded by _resolve_arg on first access.
+    mutable std::vector<boost::optional<std::string>> _raw_args;
+    int _selected = 0;
+    std::vector<std::uint8_t> _read_memory(std::uint64_t addr, std::size_t size);
+    //the cache reads whole pages, which must not touch memory that has side effects when read.
+    bool _cacheable(std::uint64_t addr, std::size_t size);
+    std::vector<std::uint8_t> _read_segment(std::uint64_t addr, std::size_t size);
+
+    boost::optional<memory_map> _local_map;
+    const memory_map & _memory_map();
+    const memory_map & _proc_maps();
+    //the direct memory access if it may be used for [addr, addr + size), nullptr if it has to go through gdb.
+    proc_memory * _direct_memory(std::uint64_t addr, std::uint64_t size);
+    //queue the evaluation of expr in the interpreter pipeline, value is only set if it succeeds.
+    void _evaluate(const std::string & expr, boost::optional<std::string> & value);
+    std::vector<std::uint8_t> _read_watched(std::uint64_t addr, std::uint64_t size);
+
+    //writes are deferred until something could observe them, so consecutive writes share one round trip.
+    struct pending_write
+    {
+        std::string expression; //empty for a memory write
+        std::uint64_t addr = 0u;
+        std::vector<std::uint8_t> data;
+    };
+    std::vector<pending_write> _pending;
+    bool _overlaps_pending(std::uint64_t addr, std::uint64_t size) const;
 };
 
 
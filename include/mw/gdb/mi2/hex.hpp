@@ -0,0 +1,209 @@
+/**
+ * @file   mw/gdb/mi2/hex.hpp
+ * @date   16.10.2026
+ * @author Klemens D. Morgenstern
+ *
+ * Published under [Apache License 2.0](http://www.apache.org/licenses/LICENSE-2.0.html)
+  <pre>
+    /  /|  (  )   |  |  /
+   /| / |   \/    | /| /
+  / |/  |   /\    |/ |/
+ /  /   |  (  \   /  |
+               )
+ </pre>
+ */
+#ifndef MW_GDB_MI2_HEX_HPP_
+#define MW_GDB_MI2_HEX_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MW_GDB_MI2_HEX_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define MW_GDB_MI2_HEX_SSE2 1
+#endif
+
+namespace mw
+{
+namespace gdb
+{
+namespace mi2
+{
+namespace detail
+{
+
+inline char hex_digit(std::uint8_t nibble)
+{
+    constexpr static char digits[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+    return digits[nibble & 0x0F];
+}
+
+///The value of a hex digit, invalid characters yield 0xFF.
+inline std::uint8_t hex_value(char c)
+{
+    if ((c >= '0' ) && (c <= '9'))
+        return c - '0';
+
+    if ((c >= 'A' ) && (c <= 'F'))
+        return c - 'A' + 10;
+
+    if ((c >= 'a' ) && (c <= 'f'))
+        return c - 'a' + 10;
+
+    return 0xFF;
+}
+
+#if defined(MW_GDB_MI2_HEX_AVX2) || defined(MW_GDB_MI2_HEX_SSE2)
+
+//nibbles to ascii: '0' + n, plus the distance to 'a' for n > 9.
+inline __m128i hex_digits(__m128i nibbles)
+{
+    auto alpha = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+    return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), alpha);
+}
+
+//ascii to nibbles, valid is set to 0xFF for every character that is a hex digit.
+inline __m128i hex_values(__m128i chars, __m128i & valid)
+{
+    auto digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    auto alpha = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+
+    auto is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    auto is_alpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+    valid = _mm_or_si128(is_digit, is_alpha);
+
+    return _mm_or_si128(_mm_and_si128(is_digit, digit),
+                        _mm_and_si128(is_alpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+}
+
+//two nibbles per 16bit lane to a byte per lane, i.e. (even << 4) | odd.
+inline __m128i hex_combine(__m128i nibbles)
+{
+    auto hi = _mm_and_si128(nibbles, _mm_set1_epi16(0x00FF));
+    auto lo = _mm_srli_epi16(nibbles, 8);
+    return _mm_or_si128(_mm_slli_epi16(hi, 4), lo);
+}
+
+#endif
+
+#if defined(MW_GDB_MI2_HEX_AVX2)
+
+inline __m256i hex_digits(__m256i nibbles)
+{
+    auto alpha = _mm256_and_si256(_mm256_cmpgt_epi8(nibbles, _mm256_set1_epi8(9)), _mm256_set1_epi8('a' - '0' - 10));
+    return _mm256_add_epi8(_mm256_add_epi8(nibbles, _mm256_set1_epi8('0')), alpha);
+}
+
+inline __m256i hex_values(__m256i chars, __m256i & valid)
+{
+    auto digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    auto alpha = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+
+    auto is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    auto is_alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+    valid = _mm256_or_si256(is_digit, is_alpha);
+
+    return _mm256_or_si256(_mm256_and_si256(is_digit, digit),
+                           _mm256_and_si256(is_alpha, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+}
+
+inline __m256i hex_combine(__m256i nibbles)
+{
+    auto hi = _mm256_and_si256(nibbles, _mm256_set1_epi16(0x00FF));
+    auto lo = _mm256_srli_epi16(nibbles, 8);
+    return _mm256_or_si256(_mm256_slli_epi16(hi, 4), lo);
+}
+
+#endif
+
+}
+
+///Write the lower case hex representation of [data, data + size) to out, which must hold 2 * size characters.
+inline void hex_encode(const std::uint8_t * data, std::size_t size, char * out)
+{
+    std::size_t i = 0u;
+#if defined(MW_GDB_MI2_HEX_AVX2)
+    const auto low_mask = _mm256_set1_epi8(0x0F);
+    for (; (size - i) >= 32u; i += 32u)
+    {
+        auto in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        auto hi = detail::hex_digits(_mm256_and_si256(_mm256_srli_epi16(in, 4), low_mask));
+        auto lo = detail::hex_digits(_mm256_and_si256(in, low_mask));
+
+        //the unpack works on 128bit lanes, so the halves need to be put back in order.
+        auto first  = _mm256_unpacklo_epi8(hi, lo);
+        auto second = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i),       _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
+    }
+#endif
+#if defined(MW_GDB_MI2_HEX_AVX2) || defined(MW_GDB_MI2_HEX_SSE2)
+    const auto low_mask16 = _mm_set1_epi8(0x0F);
+    for (; (size - i) >= 16u; i += 16u)
+    {
+        auto in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        auto hi = detail::hex_digits(_mm_and_si128(_mm_srli_epi16(in, 4), low_mask16));
+        auto lo = detail::hex_digits(_mm_and_si128(in, low_mask16));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i),      _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+#endif
+    for (; i < size; i++)
+    {
+        out[2 * i]     = detail::hex_digit(data[i] >> 4);
+        out[2 * i + 1] = detail::hex_digit(data[i]);
+    }
+}
+
+///Decode the 2 * size hex characters at in into [out, out + size).
+/** @return false if one of the characters is no hex digit, the decoded bytes up to it are written then.
+ */
+inline bool hex_decode(const char * in, std::size_t size, std::uint8_t * out)
+{
+    std::size_t i = 0u;
+#if defined(MW_GDB_MI2_HEX_AVX2)
+    for (; (size - i) >= 32u; i += 32u)
+    {
+        __m256i valid_first, valid_second;
+        auto first  = detail::hex_values(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * i)),      valid_first);
+        auto second = detail::hex_values(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * i + 32)), valid_second);
+        if (_mm256_movemask_epi8(_mm256_and_si256(valid_first, valid_second)) != -1)
+            break; //let the scalar code deal with the invalid characters.
+
+        //the pack works on 128bit lanes, so the quarters need to be put back in order.
+        auto packed = _mm256_packus_epi16(detail::hex_combine(first), detail::hex_combine(second));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+#endif
+#if defined(MW_GDB_MI2_HEX_AVX2) || defined(MW_GDB_MI2_HEX_SSE2)
+    for (; (size - i) >= 16u; i += 16u)
+    {
+        __m128i valid_first, valid_second;
+        auto first  = detail::hex_values(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i)),      valid_first);
+        auto second = detail::hex_values(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i + 16)), valid_second);
+        if (_mm_movemask_epi8(_mm_and_si128(valid_first, valid_second)) != 0xFFFF)
+            break;
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(detail::hex_combine(first), detail::hex_combine(second)));
+    }
+#endif
+    for (; i < size; i++)
+    {
+        auto hi = detail::hex_value(in[2 * i]);
+        auto lo = detail::hex_value(in[2 * i + 1]);
+        if ((hi | lo) > 0x0F)
+            return false;
+        out[i] = static_cast<std::uint8_t>((hi << 4) | lo);
+    }
+    return true;
+}
+
+}
+}
+}
+
+#endif /* MW_GDB_MI2_HEX_HPP_ */
@@ -27,6 +27,7 @@
 #include <ostream>
 #include <functional>
 #include <iostream>
+#include <deque>
 
 #include <mw/debug/interpreter_impl.hpp>
 
@@ -100,6 +101,8 @@ class interpreter : public mw::debug::interpreter_impl
     void _handle_stream_output(const stream_record & sr);
     void _handle_async_output(const async_output & ao);
     bool _handle_async_output(std::uint64_t token, const async_output & ao);
+    template<typename Func>
+    bool _read_block(Func && on_record);
     template<typename ...Args>
     void _work_impl(Args&&...args);
     void _work();
@@ -107,15 +110,37 @@ class interpreter : public mw::debug::interpreter_impl
   //  void _work(const std::function<void(const result_output&)> & func);
     void _work(std::uint64_t, const std::function<void(const result_output&)> & func);
 
-    void _handle_record(const std::string& line, const boost::optional<std::uint64_t> &token, const result_output & sr);
-    void _handle_record(const std::string& line, const boost::optional<std::uint64_t> &token, const result_output & sr,
+    void _handle_record(boost::string_view line, const boost::optional<std::uint64_t> &token, const result_output & sr);
+    void _handle_record(boost::string_view line, const boost::optional<std::uint64_t> &token, const result_output & sr,
                         std::uint64_t expected_token, result_class rc);
-//    void _handle_record(const std::string& line, const boost::optional<std::uint64_t> &token, const stream_record & sr,
+//    void _handle_record(boost::string_view line, const boost::optional<std::uint64_t> &token, const stream_record & sr,
 //                        const std::function<void(const result_output&)> & func);
-    void _handle_record(const std::string& line, const boost::optional<std::uint64_t> &token, const result_output & sr,
+    void _handle_record(boost::string_view line, const boost::optional<std::uint64_t> &token, const result_output & sr,
                         std::uint64_t expected_token, const std::function<void(const result_output&)> & func);
 
     std::vector<std::pair<std::uint64_t, std::function<bool(const async_output &)>>> _pending_asyncs;
+
+    struct pending_command
+    {
+        std::uint64_t token;
+        std::string command;
+        std::function<void(const result_output&)> handler;
+    };
+    std::deque<pending_command> _pipeline;
+    std::size_t _pipeline_window = 16 * 1024;
+    //the chunks of memory transfers are queued in batches of this size, so not all of them are held in memory.
+    std::size_t _memory_batch = 32u;
+
+    std::uint64_t _read_memory_chunked(std::uint64_t address, std::uint64_t count, std::size_t chunk_size,
+                                       const std::function<std::uint8_t*(std::uint64_t, std::size_t)> & dest,
+                                       const std::function<void(std::uint64_t, const std::uint8_t*, std::size_t)> & done);
+    //the amount read from gdb at once, the output is parsed line by line as it arrives.
+    std::size_t _read_chunk = 4096u;
+
+    //the results of an output block are allocated here, it's reset when the outermost block is read.
+    //handlers get them by const reference, so they can only copy them out, which puts them on the free store.
+    arena _arena;
+    int _read_depth = 0;
 public:
     interpreter(boost::process::async_pipe & out,
                 boost::process::async_pipe & in,
@@ -128,6 +153,26 @@ public:
     async_record_handler_t async_record_handler{_async_sink};
 
     async_result wait_for_stop();
+    /** Wait for the next stop. A breakpoint hit is decoded directly into hit and only the reason is returned,
+     * every other stop is returned as by wait_for_stop().
+     */
+    async_result wait_for_stop(breakpoint_hit & hit);
+
+    /** Queue a command for pipelined execution. The command must neither contain the token nor the trailing newline.
+     * The handler is called with the record carrying the returned token during the next call of flush.
+     * The record resides in the arena of the output block, so it's only valid during the call and needs to be copied to be kept.
+     */
+    std::uint64_t pipeline(const std::string & command, const std::function<void(const result_output&)> & handler);
+    ///Queue a command for pipelined execution, that must yield a record of the given class without results.
+    std::uint64_t pipeline(const std::string & command, result_class rc = result_class::done);
+    /** Send all queued commands at once and dispatch the records by their token, until every command was answered.
+     * If a handler throws, the remaining records are still dispatched and the first exception is rethrown afterwards.
+     */
+    void flush();
+    ///The number of queued commands, that were not yet answered.
+    std::size_t pipelined() const {return _pipeline.size();}
+    ///Set the maximum amount of bytes in flight, so the pipes cannot deadlock on large batches.
+    void set_pipeline_window(std::size_t bytes) {_pipeline_window = bytes;}
 
     //read the opening of the interpreter
     std::string read_header();
@@ -174,6 +219,14 @@ public:
             const boost::optional<int> & ignore_count = boost::none,
             const boost::optional<int> & thread_id = boost::none);
 
+    /** Queue the insertion of a breakpoint for pipelined execution, so many breakpoints can be inserted in one go.
+     * The handler is called during flush with the inserted breakpoints, or with none and the message if gdb reported an error
+     * or the reply couldn't be decoded.
+     */
+    std::uint64_t pipeline_break_insert(const std::string & location,
+            const std::function<void(std::vector<breakpoint> && bps, const std::string & error)> & handler,
+            const boost::optional<std::string> & condition = boost::none);
+
     breakpoint dprintf_insert(
             const std::string & format, const std::vector<std::string> & argument,
             const linespec_location & location,
@@ -206,6 +259,15 @@ public:
             const boost::optional<int> & ignore_count      = boost::none,
             const boost::optional<int> & thread_id         = boost::none);
 
+    /** Queue the insertion of a dprintf for pipelined execution. Format and arguments are passed as-is like to dprintf_insert,
+     * so the format must be quoted, e.g. with escape_cstring, and so must arguments containing spaces.
+     * The handler is called like the one of pipeline_break_insert.
+     */
+    std::uint64_t pipeline_dprintf_insert(const std::string & location,
+            const std::string & format, const std::vector<std::string> & argument,
+            const std::function<void(std::vector<breakpoint> && bps, const std::string & error)> & handler,
+            const boost::optional<std::string> & condition = boost::none);
+
     std::vector<breakpoint> break_list();
     void break_passcount(std::size_t tracepoint_number, std::size_t passcount);
     watchpoint break_watch(const std::string & expr, bool access = false, bool read = false);
@@ -343,6 +405,20 @@ public:
                                  const std::vector<std::uint8_t> & contents,
                                  const boost::optional<std::size_t> & count = boost::none);
 
+    ///Called with every chunk of a chunked memory read, in address order.
+    using memory_sink = std::function<void(std::uint64_t address, const std::uint8_t * data, std::size_t size)>;
+
+    /** Read [address, address + count) into out, split into pipelined commands of chunk_size bytes, which are decoded straight into out.
+     * The read stops at the first byte, that cannot be read. Returns the number of bytes read, it only throws if the first chunk fails;
+     * if a later chunk fails, the bytes read up to it are returned without an error, so a short count must be checked by the caller.
+     */
+    std::size_t data_read_memory_bytes(std::uint64_t address, std::size_t count, std::uint8_t * out, std::size_t chunk_size);
+    ///Read [address, address + count) in chunks, which are passed to sink. Only one chunk is held in memory at a time.
+    /** Errors are handled like in the overload above, i.e. a short count is returned if a later chunk fails. */
+    std::uint64_t data_read_memory_bytes(std::uint64_t address, std::uint64_t count, std::size_t chunk_size, const memory_sink & sink);
+    ///Write [data, data + size) to address, split into pipelined commands of chunk_size bytes.
+    void data_write_memory_bytes(std::uint64_t address, const std::uint8_t * data, std::size_t size, std::size_t chunk_size);
+
     boost::optional<found_tracepoint> trace_find(boost::none_t = boost::none);
     boost::optional<found_tracepoint> trace_find(const std::string & );
     boost::optional<found_tracepoint> trace_find_by_frame(int frame);
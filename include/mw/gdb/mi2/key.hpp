@@ -0,0 +1,228 @@
+/**
+ * @file   mw/gdb/mi2/key.hpp
+ * @date   16.10.2026
+ * @author Klemens D. Morgenstern
+ *
+ * Published under [Apache License 2.0](http://www.apache.org/licenses/LICENSE-2.0.html)
+  <pre>
+    /  /|  (  )   |  |  /
+   /| / |   \/    | /| /
+  / |/  |   /\    |/ |/
+ /  /   |  (  \   /  |
+               )
+ </pre>
+ */
+#ifndef MW_GDB_MI2_KEY_HPP_
+#define MW_GDB_MI2_KEY_HPP_
+
+#include <boost/utility/string_view.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+///The names of the results gdb emits that are known to the interpreter, given as X(identifier, name).
+#define MW_GDB_MI2_KEYS(X) \
+    X(addr,                              "addr") \
+    X(address,                           "address") \
+    X(args,                              "args") \
+    X(ascii,                             "ascii") \
+    X(asm_insns,                         "asm_insns") \
+    X(at,                                "at") \
+    X(begin,                             "begin") \
+    X(bkpt,                              "bkpt") \
+    X(bkptno,                            "bkptno") \
+    X(body,                              "body") \
+    X(BreakpointTable,                   "BreakpointTable") \
+    X(buffer_free,                       "buffer-free") \
+    X(buffer_size,                       "buffer-size") \
+    X(catch_type,                        "catch-type") \
+    X(changed_registers,                 "changed-registers") \
+    X(child,                             "child") \
+    X(children,                          "children") \
+    X(circular,                          "circular") \
+    X(code,                              "code") \
+    X(col_name,                          "col_name") \
+    X(colhdr,                            "colhdr") \
+    X(computed_expressions,              "computed-expressions") \
+    X(cond,                              "cond") \
+    X(contents,                          "contents") \
+    X(core,                              "core") \
+    X(cores,                             "cores") \
+    X(current,                           "current") \
+    X(current_thread_id,                 "current-thread-id") \
+    X(cwd,                               "cwd") \
+    X(data,                              "data") \
+    X(depth,                             "depth") \
+    X(details,                           "details") \
+    X(disconnected,                      "disconnected") \
+    X(disp,                              "disp") \
+    X(displayhint,                       "displayhint") \
+    X(dynamic,                           "dynamic") \
+    X(enable,                            "enable") \
+    X(enabled,                           "enabled") \
+    X(end,                               "end") \
+    X(evaluated_by,                      "evaluated-by") \
+    X(executable,                        "executable") \
+    X(exists,                            "exists") \
+    X(exit_code,                         "exit-code") \
+    X(exited,                            "exited") \
+    X(exp,                               "exp") \
+    X(explicit_variables,                "explicit-variables") \
+    X(file,                              "file") \
+    X(filename,                          "filename") \
+    X(files,                             "files") \
+    X(format,                            "format") \
+    X(found,                             "found") \
+    X(frame,                             "frame") \
+    X(frames,                            "frames") \
+    X(frames_created,                    "frames-created") \
+    X(from,                              "from") \
+    X(frozen,                            "frozen") \
+    X(fullname,                          "fullname") \
+    X(func,                              "func") \
+    X(func_name,                         "func-name") \
+    X(gid,                               "gid") \
+    X(group_id,                          "group-id") \
+    X(groups,                            "groups") \
+    X(has_more,                          "has_more") \
+    X(hdr,                               "hdr") \
+    X(host_name,                         "host-name") \
+    X(id,                                "id") \
+    X(ignore,                            "ignore") \
+    X(in_scope,                          "in_scope") \
+    X(inferior,                          "inferior") \
+    X(inferior_tty_terminal,             "inferior_tty_terminal") \
+    X(initial,                           "initial") \
+    X(inst,                              "inst") \
+    X(installed,                         "installed") \
+    X(lang,                              "lang") \
+    X(len,                               "len") \
+    X(length,                            "length") \
+    X(level,                             "level") \
+    X(line,                              "line") \
+    X(line_asm_insn,                     "line_asm_insn") \
+    X(lines,                             "lines") \
+    X(load_size,                         "load-size") \
+    X(locals,                            "locals") \
+    X(macro_info,                        "macro-info") \
+    X(mask,                              "mask") \
+    X(memory,                            "memory") \
+    X(method,                            "method") \
+    X(msg,                               "msg") \
+    X(name,                              "name") \
+    X(new_thread_id,                     "new-thread-id") \
+    X(new_children,                      "new_children") \
+    X(new_num_children,                  "new_num_children") \
+    X(new_type,                          "new_type") \
+    X(next_page,                         "next-page") \
+    X(next_row,                          "next-row") \
+    X(nr_bytes,                          "nr-bytes") \
+    X(num,                               "num") \
+    X(num_children,                      "num_children") \
+    X(number,                            "number") \
+    X(number_of_threads,                 "number-of-threads") \
+    X(numchild,                          "numchild") \
+    X(offset,                            "offset") \
+    X(opcodes,                           "opcodes") \
+    X(original_location,                 "original-location") \
+    X(param,                             "param") \
+    X(parent_id,                         "parent-id") \
+    X(pass,                              "pass") \
+    X(path,                              "path") \
+    X(path_expr,                         "path_expr") \
+    X(pc,                                "pc") \
+    X(pending,                           "pending") \
+    X(pid,                               "pid") \
+    X(prev_page,                         "prev-page") \
+    X(prev_row,                          "prev-row") \
+    X(priority,                          "priority") \
+    X(reason,                            "reason") \
+    X(register_names,                    "register-names") \
+    X(register_values,                   "register-values") \
+    X(registers,                         "registers") \
+    X(result,                            "result") \
+    X(running,                           "running") \
+    X(script,                            "script") \
+    X(section,                           "section") \
+    X(section_sent,                      "section-sent") \
+    X(section_size,                      "section-size") \
+    X(signal_meaning,                    "signal-meaning") \
+    X(signal_name,                       "signal-name") \
+    X(source_path,                       "source-path") \
+    X(src_and_asm_line,                  "src_and_asm_line") \
+    X(stack,                             "stack") \
+    X(stack_args,                        "stack-args") \
+    X(state,                             "state") \
+    X(static_tracepoint_marker_string_id,"static-tracepoint-marker-string-id") \
+    X(status,                            "status") \
+    X(stop_reason,                       "stop-reason") \
+    X(stopped_threads,                   "stopped-threads") \
+    X(stopping_tracepoint,               "stopping-tracepoint") \
+    X(supported,                         "supported") \
+    X(symbols_loaded,                    "symbols-loaded") \
+    X(target_id,                         "target-id") \
+    X(target_name,                       "target-name") \
+    X(task,                              "task") \
+    X(task_id,                           "task-id") \
+    X(thread,                            "thread") \
+    X(thread_group,                      "thread-group") \
+    X(thread_groups,                     "thread-groups") \
+    X(thread_id,                         "thread-id") \
+    X(thread_ids,                        "thread-ids") \
+    X(threads,                           "threads") \
+    X(times,                             "times") \
+    X(total_bytes,                       "total-bytes") \
+    X(total_sent,                        "total-sent") \
+    X(total_size,                        "total-size") \
+    X(trace_file,                        "trace-file") \
+    X(traceframe,                        "traceframe") \
+    X(traceframe_usage,                  "traceframe-usage") \
+    X(tracepoint,                        "tracepoint") \
+    X(transfer_rate,                     "transfer-rate") \
+    X(tvars,                             "tvars") \
+    X(type,                              "type") \
+    X(type_changed,                      "type_changed") \
+    X(value,                             "value") \
+    X(variables,                         "variables") \
+    X(what,                              "what") \
+    X(wpt,                               "wpt") \
+    X(write_rate,                        "write-rate")
+
+namespace mw
+{
+namespace gdb
+{
+namespace mi2
+{
+
+///Interned name of a result, so results can be looked up by integer compare.
+enum class key : std::uint16_t
+{
+    unknown, ///< The name is not in MW_GDB_MI2_KEYS, only the string can be used.
+#define MW_GDB_MI2_KEY_ENUM(Id, Name) Id,
+MW_GDB_MI2_KEYS(MW_GDB_MI2_KEY_ENUM)
+#undef MW_GDB_MI2_KEY_ENUM
+};
+
+///The number of keys, including key::unknown.
+#define MW_GDB_MI2_KEY_COUNT(Id, Name) + 1
+constexpr std::size_t key_count = 1 MW_GDB_MI2_KEYS(MW_GDB_MI2_KEY_COUNT);
+#undef MW_GDB_MI2_KEY_COUNT
+
+///Get the key of a result name, key::unknown if it's not interned.
+key intern(boost::string_view name);
+
+///Get the name of the key, empty for key::unknown.
+boost::string_view key_name(key k);
+
+///Convert the key to the corresponding string for debug purposes.
+inline std::string to_string(key k)
+{
+    return k == key::unknown ? "***unknown key***" : key_name(k).to_string();
+}
+
+}
+}
+}
+
+#endif /* MW_GDB_MI2_KEY_HPP_ */
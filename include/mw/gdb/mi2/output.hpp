@@ -15,13 +15,16 @@
 #ifndef MW_GDB_MI2_OUTPUT_HPP_
 #define MW_GDB_MI2_OUTPUT_HPP_
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <boost/optional.hpp>
+#include <boost/utility/string_view.hpp>
 #include <boost/variant/variant.hpp>
 #include <boost/variant/get.hpp>
-#include <boost/variant/recursive_wrapper.hpp>
 #include <mw/gdb/mi2/interpreter_error.hpp>
+#include <mw/gdb/mi2/arena.hpp>
+#include <mw/gdb/mi2/key.hpp>
 #include <cstdint>
 
 namespace mw
@@ -94,14 +97,29 @@ boost::optional<stream_record> parse_stream_output(const std::string & data);
 
 struct value;
 
+///Deleter for a value, which might reside in an arena.
+struct value_deleter
+{
+    ///The arena the value was allocated from, nullptr if it is on the free store.
+    arena * resource = nullptr;
+    inline void operator()(value * val) const;
+};
+
+///Create a value, allocated from the arena if it is not nullptr.
+inline std::unique_ptr<value, value_deleter> make_value(arena * resource = nullptr);
+
 ///A value with a key.
 struct result
 {
     std::string variable;
-    std::unique_ptr<value> value_p = std::make_unique<value>(); //shared for spirit.x3
+    ///The interned variable, set by the parser.
+    key key_ = key::unknown;
+    std::unique_ptr<value, value_deleter> value_p = make_value(); //shared for spirit.x3
     value & value_ = *value_p;
 
     result() = default;
+    ///Construct a result, with the value allocated from the arena.
+    explicit result(arena * resource) : value_p(make_value(resource)) {}
     result(const result &);
     result(result &&) = default;
 
@@ -109,20 +127,45 @@ struct result
     result & operator=(result &&) = default;
 };
 
+///A sequence of results. Copies are always allocated on the free store.
+using result_list = std::vector<result, arena_allocator<result>>;
+///A sequence of values. Copies are always allocated on the free store.
+using value_list  = std::vector<value,  arena_allocator<value>>;
+
 ///A tuple, i.e. a sequence of results.
-struct tuple : std::vector<result>
+struct tuple : result_list
 {
-    using father_type = std::vector<result>;
+    using father_type = result_list;
     using father_type::vector;
     using father_type::operator=;
 };
 
-struct list;
+///A list, i.e. a sequence of values or results.
+struct list : boost::variant<value_list, result_list>
+{
+    using father_type = boost::variant<value_list, result_list>;
+    //no converting constructors, they would make the assignment to value ambiguous.
+    using father_type::operator=;
+    ///Try to interpret it as a sequence of values. May throw unexpected_type if it is a sequence of results instead.
+    const value_list & as_values() const
+    {
+        if (type() != boost::typeindex::type_id<value_list>())
+            BOOST_THROW_EXCEPTION( unexpected_type("unexpected type [" + boost::typeindex::type_index(type()).pretty_name() + " != " + "mw::gdb::mi2::value_list]") );
+        return boost::get<value_list>(*this);
+    }
+    ///Try to interpret it as a sequence of results. May throw unexpected_type if it is a sequence of values instead.
+    const result_list & as_results() const
+    {
+        if (type() != boost::typeindex::type_id<result_list>())
+            BOOST_THROW_EXCEPTION( unexpected_type("unexpected type [" + boost::typeindex::type_index(type()).pretty_name() + " != " + "mw::gdb::mi2::result_list]") );
+        return boost::get<result_list>(*this);
+    }
+};
 
 ///A value, i.e. either a string, a tuple or a list.
-struct value : boost::variant<std::string, tuple, boost::recursive_wrapper<list>>
+struct value : boost::variant<std::string, tuple, list>
 {
-    using father_type = boost::variant<std::string, tuple, boost::recursive_wrapper<list>>;
+    using father_type = boost::variant<std::string, tuple, list>;
 
     inline value();
     template<typename T>
@@ -138,7 +181,12 @@ struct value : boost::variant<std::string, tuple, boost::recursive_wrapper<list>
         return boost::get<std::string>(*this);
     }
     ///Try to interpret it as a list. May throw unexpected_type if it is not a list.
-    inline const list &        as_list()   const;
+    inline const list &        as_list()   const
+    {
+        if (type() != boost::typeindex::type_id<list>())
+            BOOST_THROW_EXCEPTION( unexpected_type("unexpected type [" + boost::typeindex::type_index(type()).pretty_name() + " != " + "mw::gdb::mi2::list]") );
+        return boost::get<list>(*this);
+    }
     ///Try to interpret it as a tuple. May throw unexpected_tuple if it is not a tuple.
     inline const tuple&        as_tuple()  const
     {
@@ -148,37 +196,6 @@ struct value : boost::variant<std::string, tuple, boost::recursive_wrapper<list>
     }
 };
 
-///A list, i.e. a sequence of values or results.
-struct list : boost::variant<std::vector<value>, std::vector<result>>
-{
-    using father_type = boost::variant<std::vector<value>, std::vector<result>>;
-    using father_type::variant;
-    using father_type::operator=;
-    ///Try to interpret it as a sequence of values. May throw unexpected_type if it is a sequence of results instead.
-    const std::vector<value> & as_values() const
-    {
-        if (type() != boost::typeindex::type_id<std::vector<value>>())
-            BOOST_THROW_EXCEPTION( unexpected_type("unexpected type [" + boost::typeindex::type_index(type()).pretty_name() + " != " + "std::vector<value>]") );
-        return boost::get<std::vector<value>>(*this);
-    }
-    ///Try to interpret it as a sequence of results. May throw unexpected_type if it is a sequence of values instead.
-    const std::vector<result> & as_results() const
-    {
-        if (type() != boost::typeindex::type_id<std::vector<result>>())
-            BOOST_THROW_EXCEPTION( unexpected_type("unexpected type [" + boost::typeindex::type_index(type()).pretty_name() + " != " + "std::vector<result>]") );
-        return boost::get<std::vector<result>>(*this);
-    }
-};
-
-const list & value::as_list()   const
-{
-    if (type() != boost::typeindex::type_id<list>())
-        BOOST_THROW_EXCEPTION( unexpected_type("unexpected type [" + boost::typeindex::type_index(type()).pretty_name() + " != " + "mw::gdb::mi2::list]") );
-
-    return boost::get<list>(*this);
-}
-
-
 //declared here because of forward-decl.
 value::value() {};
 
@@ -188,6 +205,22 @@ value::value(T&& value) : father_type(std::forward<T>(value)) {}
 template<typename T>
 value &value::operator=(T&& rhs) { *static_cast<father_type*>(this) = std::forward<T>(rhs); return *this;}
 
+void value_deleter::operator()(value * val) const
+{
+    if (resource)
+        val->~value();
+    else
+        delete val;
+}
+
+std::unique_ptr<value, value_deleter> make_value(arena * resource)
+{
+    if (resource)
+        return std::unique_ptr<value, value_deleter>(new (resource->allocate(sizeof(value), alignof(value))) value(), value_deleter{resource});
+    else
+        return std::unique_ptr<value, value_deleter>(new value());
+}
+
 ///Class representing asynchronous output
 struct async_output
 {
@@ -201,7 +234,7 @@ struct async_output
     ///Currently only "stopped", but kept for further extensions.
     std::string class_;
     ///The actual data of the output.
-    std::vector<result> results;
+    result_list results;
 };
 
 ///The output of a synchronous operation.
@@ -210,9 +243,47 @@ struct result_output
     ///The class of the output
     result_class class_;
     ///The results of it.
-    std::vector<result> results;
+    result_list results;
+};
+
+///One line of the mi2 output, as produced by parse_line.
+/** The object is meant to be reused for consecutive lines, so the buffers of the members are kept.
+ * Only the member indicated by type is valid after parsing.
+ */
+struct output_line
+{
+    output_line() = default;
+    /** Construct the line, so that all parsed results are allocated from the arena, which needs to outlive the results.
+     * Moving the results out keeps them in the arena, they need to be copied to be kept longer.
+     */
+    explicit output_line(arena & resource) : resource(&resource)
+    {
+        async_data.results  = result_list(&resource);
+        result_data.results = result_list(&resource);
+    }
+    ///The kind of the line.
+    enum type_t
+    {
+        unknown, ///< Not an mi2 record, e.g. output of the target forwarded by gdb.
+        stream,  ///< A stream_record, stored in stream_data.
+        async,   ///< An async_output, stored in async_data.
+        result,  ///< A result_output, stored in result_data.
+        prompt   ///< The end of an output sequence, i.e. `(gdb)`.
+    } type = unknown;
+    ///The token of the record, if any.
+    boost::optional<std::uint64_t> token;
+
+    stream_record stream_data;
+    async_output  async_data;
+    result_output result_data;
+
+    ///The arena used for the results, nullptr if the free store is used.
+    arena * resource = nullptr;
 };
 
+///Parse one line (without the newline) in place, dispatching once on the leading token & prefix character.
+output_line::type_t parse_line(boost::string_view line, output_line & out);
+
 ///Try to parste the string as stream output.
 boost::optional<stream_record> parse_stream_output(const std::string & data);
 
@@ -230,7 +301,7 @@ boost::optional<std::pair<boost::optional<std::uint64_t>, result_output>> parse_
 
 std::string to_string(const stream_record & ar);
 std::string to_string(const result & res);
-std::string to_string(const std::vector<result> & tup);
+std::string to_string(const result_list & tup);
 std::string to_string(const value & val);
 std::string to_string(const list & ls);
 std::string to_string(const async_output & ao);
@@ -0,0 +1,135 @@
+/**
+ * @file   mw/gdb/mi2/page_cache.hpp
+ * @date   16.10.2026
+ * @author Klemens D. Morgenstern
+ *
+ * Published under [Apache License 2.0](http://www.apache.org/licenses/LICENSE-2.0.html)
+  <pre>
+    /  /|  (  )   |  |  /
+   /| / |   \/    | /| /
+  / |/  |   /\    |/ |/
+ /  /   |  (  \   /  |
+               )
+ </pre>
+ */
+#ifndef MW_GDB_MI2_PAGE_CACHE_HPP_
+#define MW_GDB_MI2_PAGE_CACHE_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace mw
+{
+namespace gdb
+{
+namespace mi2
+{
+
+///Page granular cache of target memory. It is only valid while the target is stopped.
+/** A miss reads all missing pages of the request plus the read-ahead in one go. If that fails,
+ * e.g. because the read-ahead hits unmapped memory, the request is read without it.
+ */
+class page_cache
+{
+    std::size_t _page_size;
+    std::size_t _read_ahead;
+    //a page might be shorter than _page_size, if the memory behind it couldn't be read.
+    std::unordered_map<std::uint64_t, std::vector<std::uint8_t>> _pages;
+
+    std::uint64_t _page_of(std::uint64_t addr) const {return addr / _page_size;}
+
+    template<typename Fetch>
+    bool _load(std::uint64_t first, std::uint64_t last, Fetch & fetch)
+    {
+        std::vector<std::uint8_t> data;
+        try
+        {
+            data = fetch(first * _page_size, (last - first + 1) * _page_size);
+        }
+        catch (...)
+        {
+            return false;
+        }
+
+        for (auto page = first; page <= last; page++)
+        {
+            auto offset = static_cast<std::size_t>((page - first) * _page_size);
+            if (offset >= data.size())
+                break;
+            auto len = (std::min)(_page_size, data.size() - offset);
+            _pages[page].assign(data.begin() + offset, data.begin() + offset + len);
+        }
+        return true;
+    }
+public:
+    ///Construct the cache, a page size of zero disables it.
+    explicit page_cache(std::size_t page_size = 256u, std::size_t read_ahead = 1u)
+        : _page_size(page_size), _read_ahead(read_ahead) {}
+
+    bool enabled() const {return _page_size != 0u;}
+    std::size_t page_size()  const {return _page_size;}
+    std::size_t read_ahead() const {return _read_ahead;}
+
+    ///Drop all pages, must be called when the target memory might have changed.
+    void invalidate() {_pages.clear();}
+
+    ///The number of cached pages.
+    std::size_t size() const {return _pages.size();}
+
+    /** Read memory through the cache. fetch(addr, size) must return the target memory, which may be shorter than requested.
+     * The result is shorter than size, if not all of the memory could be read.
+     */
+    template<typename Fetch>
+    std::vector<std::uint8_t> read(std::uint64_t addr, std::size_t size, Fetch && fetch)
+    {
+        if (!enabled() || (size == 0u))
+            return fetch(addr, size);
+
+        auto first = _page_of(addr);
+        auto last  = _page_of(addr + size - 1);
+
+        auto missing = first;
+        while ((missing <= last) && _pages.count(missing))
+            missing++;
+
+        if (missing <= last)
+        {
+            auto last_missing = last;
+            while (_pages.count(last_missing))
+                last_missing--;
+
+            if (!_load(missing, last_missing + _read_ahead, fetch) &&
+                ((_read_ahead == 0u) || !_load(missing, last_missing, fetch)))
+                return fetch(addr, size); //let it report the error.
+        }
+
+        std::vector<std::uint8_t> res;
+        res.reserve(size);
+        for (auto page = first; page <= last; page++)
+        {
+            auto itr = _pages.find(page);
+            if (itr == _pages.end())
+                break;
+
+            auto & data = itr->second;
+            auto page_begin = page * _page_size;
+            auto begin = static_cast<std::size_t>((std::max)(addr, page_begin) - page_begin);
+            auto end   = static_cast<std::size_t>((std::min)(addr + size, page_begin + _page_size) - page_begin);
+            if (begin >= data.size())
+                break;
+
+            res.insert(res.end(), data.begin() + begin, data.begin() + (std::min)(end, data.size()));
+            if (data.size() < end) //the rest is not readable.
+                break;
+        }
+        return res;
+    }
+};
+
+}
+}
+}
+
+#endif /* MW_GDB_MI2_PAGE_CACHE_HPP_ */
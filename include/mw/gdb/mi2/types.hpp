@@ -30,13 +30,18 @@ namespace mw {
 namespace gdb {
 namespace mi2 {
 
-const value& find(const std::vector<result> & input, const char * id);
-boost::optional<const value&> find_if(const std::vector<result> & input, const char * id);
+const value& find(const result_list & input, const char * id);
+boost::optional<const value&> find_if(const result_list & input, const char * id);
+
+///Find a result by its interned key, i.e. by integer compare.
+const value& find(const result_list & input, key id);
+///Find a result by its interned key, i.e. by integer compare.
+boost::optional<const value&> find_if(const result_list & input, key id);
 
 struct async_output;
 struct result_output;
 
-template<typename T> T parse_result(const std::vector<result>  &);
+template<typename T> T parse_result(const result_list  &);
 
 struct missing_value : interpreter_error
 {
@@ -50,7 +55,7 @@ struct missing_value : interpreter_error
 struct async_result
 {
     std::string reason;
-    std::vector<result> content;
+    result_list content;
 
     template<typename T>
     T as() const {return parse_result<T>(content);}
@@ -231,6 +236,12 @@ struct breakpoint
     boost::optional<std::string> what;
 };
 
+///Decode the bkpt results of a -break-insert.
+/** The first one is the breakpoint, the unnamed ones following it are its locations if it has multiple (in mi2).
+ *  The locations take the type & disposition of the breakpoint, since they have none of their own.
+ */
+std::vector<breakpoint> parse_breakpoints(const result_list & results);
+
 struct breakpoint_created  { breakpoint bkpt; };
 struct breakpoint_modified { breakpoint bkpt; };
 struct breakpoint_deleted  { int number;};
@@ -304,6 +315,27 @@ struct frame
     boost::optional<std::vector<arg>> args;
 };
 
+///The content of a `*stopped,reason="breakpoint-hit"` record.
+/** It is decoded in one pass by parse_breakpoint_hit. Missing strings are left empty, missing numbers are -1.
+ * The object is meant to be reused, so the storage of the strings & args is kept between hits.
+ */
+struct breakpoint_hit
+{
+    int bkptno    = -1;
+    int thread_id = -1;
+    int core      = -1;
+    boost::optional<std::uint64_t> addr;
+    std::string func;
+    std::string file;
+    std::string fullname;
+    int line = -1;
+    bool has_args = false;
+    std::vector<arg> args;
+};
+
+///Decode the results of a breakpoint-hit stop into hit, returns false if no bkptno is given.
+bool parse_breakpoint_hit(const result_list & results, breakpoint_hit & hit);
+
 struct thread_info
 {
     int id;
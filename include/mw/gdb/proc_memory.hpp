@@ -0,0 +1,124 @@
+/**
+ * @file   mw/gdb/proc_memory.hpp
+ * @date   16.10.2026
+ * @author Klemens D. Morgenstern
+ *
+ * Published under [Apache License 2.0](http://www.apache.org/licenses/LICENSE-2.0.html)
+  <pre>
+    /  /|  (  )   |  |  /
+   /| / |   \/    | /| /
+  / |/  |   /\    |/ |/
+ /  /   |  (  \   /  |
+               )
+ </pre>
+ */
+#ifndef MW_GDB_PROC_MEMORY_HPP_
+#define MW_GDB_PROC_MEMORY_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace mw
+{
+namespace gdb
+{
+
+///Direct access to the memory of a local inferior through /proc/<pid>/mem.
+/** This is only available on linux and only valid while the inferior is stopped. Every failure is reported by returning false,
+ * so the caller can fall back to the debugger. A partial transfer counts as a failure.
+ *
+ * The memory is accessed as it is, i.e. with the traps of inserted software breakpoints instead of the original code gdb keeps
+ * in its shadow copies. So code and breakpoint locations must be accessed through the debugger.
+ */
+class proc_memory
+{
+    int _pid = -1;
+    int _fd  = -1;
+public:
+    proc_memory() = default;
+    proc_memory(const proc_memory &) = delete;
+    proc_memory & operator=(const proc_memory &) = delete;
+    ~proc_memory() {close();}
+
+    ///Open the memory of the process, returns false if it's not accessible.
+    bool open(int pid)
+    {
+        close();
+#if defined(__linux__)
+        auto path = "/proc/" + std::to_string(pid) + "/mem";
+        _fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+        if (_fd == -1)
+            _fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (_fd != -1)
+            _pid = pid;
+        return _fd != -1;
+#else
+        (void)pid;
+        return false;
+#endif
+    }
+
+    void close()
+    {
+#if defined(__linux__)
+        if (_fd != -1)
+            ::close(_fd);
+#endif
+        _fd  = -1;
+        _pid = -1;
+    }
+
+    bool is_open() const {return _fd != -1;}
+    int pid() const {return _pid;}
+
+    ///Read size bytes at addr into out.
+    bool read(std::uint64_t addr, std::size_t size, std::vector<std::uint8_t> & out)
+    {
+        out.resize(size);
+#if defined(__linux__)
+        std::size_t done = 0u;
+        while (is_open() && (done < size))
+        {
+            auto res = ::pread(_fd, out.data() + done, size - done, static_cast<off_t>(addr + done));
+            if (res <= 0)
+                break;
+            done += static_cast<std::size_t>(res);
+        }
+        return done == size;
+#else
+        (void)addr;
+        return false;
+#endif
+    }
+
+    ///Write the content of data at addr.
+    bool write(std::uint64_t addr, const std::vector<std::uint8_t> & data)
+    {
+#if defined(__linux__)
+        std::size_t done = 0u;
+        while (is_open() && (done < data.size()))
+        {
+            auto res = ::pwrite(_fd, data.data() + done, data.size() - done, static_cast<off_t>(addr + done));
+            if (res <= 0)
+                break;
+            done += static_cast<std::size_t>(res);
+        }
+        return done == data.size();
+#else
+        (void)addr;
+        (void)data;
+        return false;
+#endif
+    }
+};
+
+}
+}
+
+#endif /* MW_GDB_PROC_MEMORY_HPP_ */
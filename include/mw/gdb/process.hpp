@@ -27,7 +27,14 @@
 #include <boost/process/async_pipe.hpp>
 
 #include <mw/gdb/mi2/interpreter.hpp>
-
+#include <mw/gdb/proc_memory.hpp>
+#include <mw/gdb/memory_dump.hpp>
+#include <mw/gdb/memory_map.hpp>
+#include <mw/gdb/shadow_memory.hpp>
+#include <mw/gdb/arg_cache.hpp>
+#include <mw/gdb/trace_filter.hpp>
+
+#include <algorithm>
 #include <iterator>
 
 #include <string>
@@ -36,6 +43,7 @@
 #include <fstream>
 #include <regex>
 #include <map>
+#include <unordered_map>
 
 
 namespace mw {
@@ -43,10 +51,23 @@ namespace gdb {
 
 using mw::debug::break_point;
 
+namespace mi2 { struct frame_impl; }
+
 class process : public mw::debug::process
 {
 
-    std::map<int, break_point*>               _break_point_map;
+    //indexed by the gdb breakpoint number, and the reverse. Only main numbers are kept, the locations of a breakpoint ("2.1") are hit,
+    //disabled and enabled by its number.
+    std::vector<break_point*>                                   _break_point_table;
+    std::unordered_map<const break_point*, std::vector<int>>    _break_point_numbers;
+    void _add_break_point(int number, break_point * bp);
+    //the addresses of the inserted locations, sorted. gdb keeps the original code there in a shadow copy.
+    std::vector<std::uint64_t> _break_point_addresses;
+
+    //trace points are installed as dprintf, their output is found by the tag and the index.
+    std::vector<mw::debug::trace_point*> _trace_points;
+    trace_filter _trace_filter{"mw-trace "};
+    void _trace_output(const std::string & st);
     void _run_impl(boost::asio::yield_context &yield) override;
 
     void _read_header(mi2::interpreter & interpreter);
@@ -68,10 +89,113 @@ class process : public mw::debug::process
     void _start_local (mi2::interpreter & interpreter);
     void _handle_bps  (mi2::interpreter & interpreter);
 
+    std::size_t _mem_page_size  = 256u;
+    std::size_t _mem_read_ahead = 1u;
+    std::size_t _mem_chunk_size = 64u * 1024u;
+    std::size_t _cstring_max_length = 64u * 1024u;
+
+    bool _direct_memory = true;
+    proc_memory _proc_memory;
+
+    std::vector<dump_region> _dump_regions;
+    bool _dump_at_exit   = true;
+    bool _dump_at_signal = true;
+    bool _dump_sparse    = true;
+    void _dump(mi2::frame_impl & fi, const char * trigger);
+
+    bool _use_memory_map    = true;
+    bool _memory_map_loaded = false;
+    memory_map _memory_map;
+
+    shadow_memory _watched_memory;
+
+    arg_cache _arg_cache;
+    boost::filesystem::path _arg_cache_file;
+    boost::filesystem::path _arg_cache_exe;
+public:
+    ///The size of an expression together with the type of its address, which is needed to tell if it still holds.
+    struct type_size
+    {
+        std::string type;
+        std::size_t size;
+    };
+private:
+    std::unordered_map<std::string, type_size> _type_sizes;
 public:
     void reset_timer();
 
-    const std::map<int, break_point*> & break_point_map() const {return _break_point_map;}
+    ///The breakpoint with the given gdb number, nullptr if it's not one of ours.
+    break_point * break_point_at(int number) const
+    {
+        return ((number >= 0) && (static_cast<std::size_t>(number) < _break_point_table.size())) ? _break_point_table[number] : nullptr;
+    }
+    ///All gdb numbers of the breakpoint, empty if it was not set.
+    const std::vector<int> & break_point_numbers(const break_point & bp) const
+    {
+        static const std::vector<int> none;
+        auto itr = _break_point_numbers.find(&bp);
+        return itr == _break_point_numbers.end() ? none : itr->second;
+    }
+
+    ///Configure the memory cache used during a stop. A page size of zero disables it.
+    void set_memory_cache(std::size_t page_size, std::size_t read_ahead)
+    {
+        _mem_page_size  = page_size;
+        _mem_read_ahead = read_ahead;
+    }
+    std::size_t memory_page_size()  const {return _mem_page_size;}
+    std::size_t memory_read_ahead() const {return _mem_read_ahead;}
+
+    ///Set the size of the chunks large memory transfers are split into. Zero transfers everything at once.
+    void set_memory_chunk_size(std::size_t size) {_mem_chunk_size = size;}
+    std::size_t memory_chunk_size() const {return _mem_chunk_size;}
+
+    ///Set the maximum length of the strings read by frame::get_cstring.
+    void set_cstring_max_length(std::size_t length) {_cstring_max_length = length;}
+    std::size_t cstring_max_length() const {return _cstring_max_length;}
+
+    ///Add a memory region, that is dumped into a file when the target exits or stops on a signal.
+    void add_dump_region(const dump_region & region) {_dump_regions.push_back(region);}
+    ///Select when the dump regions are written, exit means that a breakpoint called frame::set_exit.
+    void set_dump_triggers(bool at_exit, bool at_signal)
+    {
+        _dump_at_exit   = at_exit;
+        _dump_at_signal = at_signal;
+    }
+    void set_dump_sparse(bool sparse) {_dump_sparse = sparse;}
+
+    ///Check reads against the memory map of the target, so unmapped memory is not read.
+    void set_use_memory_map(bool use) {_use_memory_map = use;}
+    bool use_memory_map() const {return _use_memory_map;}
+    ///The memory map of the target as given by `info mem`, loaded on first use. It is empty if unknown.
+    const memory_map & target_memory_map(mi2::interpreter & interpreter);
+
+    ///The memory regions watched by frame::watch_memory, they outlive the frame of a single stop.
+    shadow_memory & watched_memory() {return _watched_memory;}
+
+    ///The sizes of the expressions printed bitwise, they are kept for the whole run.
+    std::unordered_map<std::string, type_size> & type_size_cache() {return _type_sizes;}
+
+    ///Store the argument names of the breakpoint locations in file, so the next run of the same executable doesn't need to query them.
+    void set_arg_cache(const boost::filesystem::path & file, const boost::filesystem::path & exe)
+    {
+        _arg_cache_file = file;
+        _arg_cache_exe  = exe;
+    }
+
+    ///The target is started by gdb on this machine, i.e. neither remote nor started by an init script.
+    bool is_local() const {return _remote.empty() && _init_scripts.empty();}
+
+    ///Allow memory access through /proc/<pid>/mem for local targets.
+    void set_direct_memory(bool enable) {_direct_memory = enable;}
+    ///The direct memory access, nullptr if it is not available.
+    proc_memory * direct_memory() {return _proc_memory.is_open() ? &_proc_memory : nullptr;}
+    ///Check if [addr, addr + size) contains the location of an inserted breakpoint.
+    bool overlaps_break_point(std::uint64_t addr, std::uint64_t size) const
+    {
+        auto itr = std::lower_bound(_break_point_addresses.begin(), _break_point_addresses.end(), addr);
+        return (itr != _break_point_addresses.end()) && ((*itr - addr) < size);
+    }
 
     process(const boost::filesystem::path & gdb, const std::string & exe, const std::vector<std::string> & args = {});
     ~process() = default;
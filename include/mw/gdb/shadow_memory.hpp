@@ -0,0 +1,171 @@
+/**
+ * @file   mw/gdb/shadow_memory.hpp
+ * @date   16.10.2026
+ * @author Klemens D. Morgenstern
+ *
+ * Published under [Apache License 2.0](http://www.apache.org/licenses/LICENSE-2.0.html)
+  <pre>
+    /  /|  (  )   |  |  /
+   /| / |   \/    | /| /
+  / |/  |   /\    |/ |/
+ /  /   |  (  \   /  |
+               )
+ </pre>
+ */
+#ifndef MW_GDB_SHADOW_MEMORY_HPP_
+#define MW_GDB_SHADOW_MEMORY_HPP_
+
+#include <mw/debug/frame.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MW_GDB_SHADOW_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define MW_GDB_SHADOW_SSE2 1
+#endif
+
+namespace mw
+{
+namespace gdb
+{
+namespace detail
+{
+
+inline void add_range(std::vector<mw::debug::memory_range> & out, std::uint64_t addr, std::uint64_t size)
+{
+    if (!out.empty() && (out.back().addr + out.back().size >= addr))
+    {
+        auto end = (std::max)(out.back().addr + out.back().size, addr + size);
+        out.back().size = end - out.back().addr;
+    }
+    else
+        out.push_back({addr, size});
+}
+
+inline void diff_bytes(const std::uint8_t * old, const std::uint8_t * now, std::size_t begin, std::size_t end,
+                       std::uint64_t addr, std::vector<mw::debug::memory_range> & out)
+{
+    for (auto i = begin; i < end; i++)
+        if (old[i] != now[i])
+            add_range(out, addr + i, 1u);
+}
+
+}
+
+/** Append the ranges in which old and now differ to out, addr is the address of the first byte.
+ * Adjacent ranges are merged, blocks without a difference are skipped with a vector compare.
+ */
+inline void diff_memory(const std::uint8_t * old, const std::uint8_t * now, std::size_t size,
+                        std::uint64_t addr, std::vector<mw::debug::memory_range> & out)
+{
+    std::size_t i = 0u;
+#if defined(MW_GDB_SHADOW_AVX2)
+    for (; (size - i) >= 32u; i += 32u)
+    {
+        auto eq = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(old + i)),
+                                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(now + i)));
+        if (_mm256_movemask_epi8(eq) != -1)
+            detail::diff_bytes(old, now, i, i + 32u, addr, out);
+    }
+#endif
+#if defined(MW_GDB_SHADOW_AVX2) || defined(MW_GDB_SHADOW_SSE2)
+    for (; (size - i) >= 16u; i += 16u)
+    {
+        auto eq = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(old + i)),
+                                 _mm_loadu_si128(reinterpret_cast<const __m128i*>(now + i)));
+        if (_mm_movemask_epi8(eq) != 0xFFFF)
+            detail::diff_bytes(old, now, i, i + 16u, addr, out);
+    }
+#endif
+    detail::diff_bytes(old, now, i, size, addr, out);
+}
+
+///The watched memory regions with a copy of their content at the last stop they were checked.
+/** Writes reported by the debugger through `=memory-changed` are remembered and reported with the next diff,
+ * so a write of an unchanged value is not lost.
+ */
+class shadow_memory
+{
+    struct region
+    {
+        std::vector<std::uint8_t> shadow;
+        std::uint64_t size;
+        std::vector<mw::debug::memory_range> written;
+    };
+    std::map<std::uint64_t, region> _regions;
+public:
+    ///Start watching the region at addr, the data is the reference for the first diff.
+    void watch(std::uint64_t addr, std::uint64_t size, std::vector<std::uint8_t> data)
+    {
+        auto & r = _regions[addr];
+        r.shadow = std::move(data);
+        r.size   = size;
+        r.written.clear();
+    }
+    void unwatch(std::uint64_t addr) {_regions.erase(addr);}
+
+    bool watched(std::uint64_t addr) const {return _regions.count(addr) != 0u;}
+    bool empty() const {return _regions.empty();}
+    ///The size of the watched region at addr, zero if it is not watched.
+    std::uint64_t size(std::uint64_t addr) const
+    {
+        auto itr = _regions.find(addr);
+        return itr == _regions.end() ? 0u : itr->second.size;
+    }
+
+    ///Record a write reported by the debugger.
+    void mark(std::uint64_t addr, std::uint64_t len)
+    {
+        for (auto & r : _regions)
+        {
+            auto begin = (std::max)(addr, r.first);
+            auto end   = (std::min)(addr + len, r.first + r.second.size);
+            if (begin < end)
+                r.second.written.push_back({begin, end - begin});
+        }
+    }
+
+    /** Compare the current content of the region at addr with the shadow and make it the new shadow.
+     * The content might be shorter than the region, if it's not completely readable; the rest of the shadow is kept then.
+     * @return The changed ranges in address order.
+     */
+    std::vector<mw::debug::memory_range> update(std::uint64_t addr, const std::vector<std::uint8_t> & now)
+    {
+        std::vector<mw::debug::memory_range> res;
+        auto itr = _regions.find(addr);
+        if (itr == _regions.end())
+            return res;
+
+        auto & r = itr->second;
+        auto common = (std::min)(r.shadow.size(), now.size());
+        diff_memory(r.shadow.data(), now.data(), common, addr, res);
+        if (now.size() > common) //the region became readable
+            detail::add_range(res, addr + common, now.size() - common);
+
+        if (!r.written.empty())
+        {
+            auto written = std::move(r.written);
+            r.written.clear();
+            written.insert(written.end(), res.begin(), res.end());
+            std::sort(written.begin(), written.end(),
+                      [](const mw::debug::memory_range & lhs, const mw::debug::memory_range & rhs){return lhs.addr < rhs.addr;});
+            res.clear();
+            for (auto & w : written)
+                detail::add_range(res, w.addr, w.size);
+        }
+
+        std::copy(now.begin(), now.begin() + common, r.shadow.begin());
+        r.shadow.insert(r.shadow.end(), now.begin() + common, now.end());
+        return res;
+    }
+};
+
+}
+}
+
+#endif /* MW_GDB_SHADOW_MEMORY_HPP_ */
@@ -0,0 +1,90 @@
+/**
+ * @file   mw/gdb/trace_filter.hpp
+ * @date   16.10.2026
+ * @author Klemens D. Morgenstern
+ *
+ * Published under [Apache License 2.0](http://www.apache.org/licenses/LICENSE-2.0.html)
+  <pre>
+    /  /|  (  )   |  |  /
+   /| / |   \/    | /| /
+  / |/  |   /\    |/ |/
+ /  /   |  (  \   /  |
+               )
+ </pre>
+ */
+#ifndef MW_GDB_TRACE_FILTER_HPP_
+#define MW_GDB_TRACE_FILTER_HPP_
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace mw
+{
+namespace gdb
+{
+
+/**Picks the output of the trace points out of the console stream.
+ * Each trace line is printed as "<tag><index>:<text>\n", but gdb might split it across several console records
+ * and other output without a trailing newline can precede the tag.
+ */
+class trace_filter
+{
+    std::string _tag;
+    std::string _line;
+public:
+    explicit trace_filter(std::string tag) : _tag(std::move(tag)) {}
+
+    const std::string & tag() const {return _tag;}
+
+    /**Feed a console record.
+     *
+     * @param st The text of the record.
+     * @param count The number of trace points, lines with an index out of range are dropped.
+     * @param sink Called as sink(index, text) for every complete trace line, without the trailing newline.
+     */
+    template<typename Sink>
+    void feed(const std::string & st, std::size_t count, Sink && sink)
+    {
+        _line += st;
+        std::size_t end;
+        while ((end = _line.find('\n')) != std::string::npos)
+        {
+            auto line = _line.substr(0, end);
+            _line.erase(0, end + 1);
+
+            auto pos = line.find(_tag);
+            if (pos == std::string::npos)
+                continue;
+            pos += _tag.size();
+
+            auto colon = line.find(':', pos);
+            if (colon == std::string::npos)
+                continue;
+
+            std::size_t idx;
+            try
+            {
+                std::size_t used;
+                auto num = line.substr(pos, colon - pos);
+                idx = std::stoul(num, &used);
+                if (used != num.size())
+                    continue;
+            }
+            catch (std::logic_error &)
+            {
+                continue;
+            }
+            if (idx >= count)
+                continue;
+
+            sink(idx, line.substr(colon + 1));
+        }
+    }
+};
+
+}
+}
+
+#endif /* MW_GDB_TRACE_FILTER_HPP_ */
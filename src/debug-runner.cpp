@@ -66,6 +66,16 @@ struct options_t
     po::variables_map vm;
 
     int time_out = -1;
+    std::size_t mem_page_size  = 256u;
+    std::size_t mem_read_ahead = 1u;
+    std::size_t mem_chunk_size = 64u * 1024u;
+    std::size_t cstring_max_length = 64u * 1024u;
+    vector<string> dump_regions;
+    vector<string> dump_at;
+    bool dump_dense = false;
+    bool no_direct_memory = false;
+    bool no_memory_map = false;
+    string arg_cache;
 
     po::positional_options_description pos;
 
@@ -186,6 +196,16 @@ struct options_t
             ("debug,D",       bool_switch(&debug),                                "output the interaction with the debugger into the log.")
             ("remote,R",      value<string>(&remote),                             "Remote settings")
             ("init-script,I", value<vector<string>>(&init_scripts)->multitoken(), "Init-Scripts for the debugger")
+            ("mem-page-size", value<std::size_t>(&mem_page_size)->default_value(256u), "page size of the memory cache used during a breakpoint, 0 disables it")
+            ("mem-read-ahead",value<std::size_t>(&mem_read_ahead)->default_value(1u),  "pages read ahead by the memory cache")
+            ("mem-chunk-size",value<std::size_t>(&mem_chunk_size)->default_value(64u * 1024u), "size of the chunks large memory transfers are split into, 0 disables it")
+            ("cstring-max-length", value<std::size_t>(&cstring_max_length)->default_value(64u * 1024u), "maximum length of strings read from the target")
+            ("dump-region",   value<vector<string>>(&dump_regions)->multitoken(),   "memory regions dumped into files, as addr:size:file")
+            ("dump-at",       value<vector<string>>(&dump_at)->multitoken(),        "when to dump the regions: exit, signal. Both if not set")
+            ("dump-dense",    bool_switch(&dump_dense),                           "write the pages of a dump that are all zero, instead of leaving holes")
+            ("no-direct-memory", bool_switch(&no_direct_memory),                  "don't access the memory of a local target through /proc/<pid>/mem")
+            ("no-memory-map", bool_switch(&no_memory_map),                       "don't check memory reads against the memory map of the target")
+            ("arg-cache",     value<string>(&arg_cache),                          "file to keep the argument names of the breakpoints in between runs")
             ;
 
         pos.add("dbg", 1).add("exe", 1);
@@ -352,6 +372,39 @@ int main(int argc, char * argv[])
     }
 
     proc.set_timeout(opt.time_out);
+    proc.set_memory_cache(opt.mem_page_size, opt.mem_read_ahead);
+    proc.set_memory_chunk_size(opt.mem_chunk_size);
+    proc.set_cstring_max_length(opt.cstring_max_length);
+    proc.set_direct_memory(!opt.no_direct_memory);
+    proc.set_use_memory_map(!opt.no_memory_map);
+    if (!opt.arg_cache.empty())
+        proc.set_arg_cache(opt.arg_cache, opt.exe);
+
+    for (auto & dr : opt.dump_regions)
+    {
+        //the file might contain ':' itself, e.g. on windows.
+        auto first  = dr.find(':');
+        auto second = first == string::npos ? string::npos : dr.find(':', first + 1);
+        try
+        {
+            if (second == string::npos)
+                throw std::invalid_argument(dr);
+            proc.add_dump_region({std::stoull(dr.substr(0, first), nullptr, 0),
+                                  std::stoull(dr.substr(first + 1, second - first - 1), nullptr, 0),
+                                  dr.substr(second + 1)});
+        }
+        catch (std::logic_error &)
+        {
+            std::cerr << "invalid dump-region '" << dr << "', expected addr:size:file" << std::endl;
+            return 1;
+        }
+    }
+    if (!opt.dump_at.empty())
+    {
+        auto has = [&](const char * trigger){return std::find(opt.dump_at.begin(), opt.dump_at.end(), trigger) != opt.dump_at.end();};
+        proc.set_dump_triggers(has("exit"), has("signal"));
+    }
+    proc.set_dump_sparse(!opt.dump_dense);
     proc.run();
 
     proc.log() << "Exited with code: " << proc.exit_code() << endl;
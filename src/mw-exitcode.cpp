@@ -36,7 +36,7 @@ struct exit_stub : mw::debug::break_point
 void exit_stub::invoke(mw::debug::frame & fr, const std::string & file, int line)
 {
     fr.log() << "***mw-newlib*** Log: Invoking _exit" << std::endl;
-    fr.set_exit(std::stoi(fr.arg_list().at(0).value));
+    fr.set_exit(std::stoi(fr.arg_list(0).value));
 }
 //]
 //[exit_stub_export
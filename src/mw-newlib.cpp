@@ -224,7 +224,7 @@ struct mw_func_stub : break_point
 
     void invoke(frame & fr, const std::string & file, int line) override
     {
-        auto type = fr.arg_list().at(0);
+        auto type = fr.arg_list(0);
         if (type.id != "func_type")
             return;
 
@@ -253,7 +253,7 @@ struct mw_func_stub : break_point
     }
     void close(frame & fr)
     {
-        auto fd = std::stoi(fr.arg_list().at(3).value);
+        auto fd = std::stoi(fr.arg_list(3).value);
         auto ret = call(close, fd);
 
         fr.log() << "***mw_newlib*** Log: Invoking close(" << fd << ") -> " << ret << std::endl;
@@ -262,7 +262,7 @@ struct mw_func_stub : break_point
     }
     void fstat(frame & fr)
     {
-        auto fd = std::stoi(fr.arg_list().at(3).value);
+        auto fd = std::stoi(fr.arg_list(3).value);
 
 #if defined (BOOST_WINDOWS_API)
  #if defined (_WIN64)
@@ -295,7 +295,7 @@ struct mw_func_stub : break_point
 
     void isatty(frame & fr)
     {
-        auto fd = std::stoi(fr.arg_list().at(3).value);
+        auto fd = std::stoi(fr.arg_list(3).value);
         auto ret = call(isatty, fd);
 
         fr.log() << "***mw_newlib*** Log: Invoking isatty(" << fd << ") -> " << ret << std::endl;
@@ -324,9 +324,9 @@ struct mw_func_stub : break_point
 
     void lseek(frame & fr)
     {
-        auto fd  = std::stoi(fr.arg_list().at(3).value);
-        auto ptr = std::stoi(fr.arg_list().at(4).value);
-        auto dir_in = std::stoi(fr.arg_list().at(5).value);
+        auto fd  = std::stoi(fr.arg_list(3).value);
+        auto ptr = std::stoi(fr.arg_list(4).value);
+        auto dir_in = std::stoi(fr.arg_list(5).value);
 
         if (!sf.inited)
             sf.load(fr);
@@ -344,8 +344,8 @@ struct mw_func_stub : break_point
     void open(frame & fr)
     {
         auto file  = fr.get_cstring(1);
-        auto flags_in = std::stoi(fr.arg_list().at(3).value);
-        auto mode_in  = std::stoi(fr.arg_list().at(4).value);
+        auto flags_in = std::stoi(fr.arg_list(3).value);
+        auto mode_in  = std::stoi(fr.arg_list(4).value);
 
 #if defined(BOOST_POSIX_API)
         boost::algorithm::replace_all(file, "\\", "/");
@@ -373,8 +373,8 @@ struct mw_func_stub : break_point
 
     void read(frame & fr)
     {
-        auto fd  = std::stoi(fr.arg_list().at(3).value);
-        auto len = std::stoi(fr.arg_list().at(4).value);
+        auto fd  = std::stoi(fr.arg_list(3).value);
+        auto len = std::stoi(fr.arg_list(4).value);
         auto ptr = std::stoull(fr.arg_list(6).value, nullptr, 16);
         std::vector<std::uint8_t> buf(len, static_cast<char>(0));
 
@@ -388,7 +388,7 @@ struct mw_func_stub : break_point
 
     void stat(frame & fr)
     {
-        auto file = fr.arg_list().at(1).value;
+        auto file = fr.arg_list(1).value;
 #if defined (BOOST_WINDOWS_API)
  #if defined (_WIN64)
         struct _stat64i32 st;
@@ -457,14 +457,15 @@ struct mw_func_stub : break_point
 
     void write(frame & fr)
     {
-        auto fd  = std::stoi(fr.arg_list().at(3).value);
-        auto len = std::stoi(fr.arg_list().at(4).value);
+        auto fd  = std::stoi(fr.arg_list(3).value);
+        auto len = std::stoi(fr.arg_list(4).value);
         auto ptr = std::stoull(fr.arg_list(6).value, nullptr, 16);
     
+        //the data is shorter than len, if the buffer is only partially readable.
         auto data = fr.read_memory(ptr, len);
-        auto ret = call(write, fd, data.data(), len);
+        auto ret = call(write, fd, data.data(), data.size());
 
-        fr.log() << "***mw_newlib*** Log: Invoking write(" << fd << ", ***local pointer***, " << len << ") -> " << ret << std::endl;
+        fr.log() << "***mw_newlib*** Log: Invoking write(" << fd << ", ***local pointer***, " << data.size() << ") -> " << ret << std::endl;
 
         fr.return_(std::to_string(ret));
     }
@@ -14,9 +14,14 @@
  */
 
 #include <mw/gdb/mi2/frame_impl.hpp>
+#include <mw/gdb/mi2/cstring.hpp>
+#include <mw/gdb/mi2/hex.hpp>
 #include <mw/gdb/mi2/interpreter.hpp>
 #include <algorithm>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <boost/algorithm/string.hpp>
 
 #define __assume(val)
@@ -175,6 +180,7 @@ struct action<reference> : pegtl::normal<hex_num>
 
 std::unordered_map<std::string, std::uint64_t> frame_impl::regs()
 {
+    flush();
     std::unordered_map<std::string, std::uint64_t> mp;
     auto reg_names = _interpreter.data_list_register_names();
     auto regs = _interpreter.data_list_register_values(format_spec::hexadecimal);
@@ -196,18 +202,112 @@ std::unordered_map<std::string, std::uint64_t> frame_impl::regs()
 
 void frame_impl::set(const std::string &var, const std::string & val)
 {
-    _interpreter.data_evaluate_expression('"' + var + " = " + val + '"');
-    proc.reset_timer();
+    _cache.invalidate();
+    pending_write pw;
+    pw.expression = var + " = " + val;
+    _pending.push_back(std::move(pw));
 }
 
 void frame_impl::set(const std::string &var, std::size_t idx, const std::string & val)
 {
-    _interpreter.data_evaluate_expression('"' + var + "[" + std::to_string(idx) + "] = " + val + '"');
+    _cache.invalidate();
+    pending_write pw;
+    pw.expression = var + "[" + std::to_string(idx) + "] = " + val;
+    _pending.push_back(std::move(pw));
+}
+
+void frame_impl::flush()
+{
+    if (_pending.empty())
+        return;
+
+    auto pending = std::move(_pending);
+    _pending.clear();
+    //pages read since the writes were queued don't overlap them, but their read-ahead might.
+    _cache.invalidate();
+
+    //a failing write must not drop the ones queued behind it, so all are sent and the first error is rethrown at the end.
+    std::exception_ptr error;
+    auto flush_pipeline = [&]
+            {
+                try
+                {
+                    _interpreter.flush();
+                }
+                catch (...)
+                {
+                    if (!error)
+                        error = std::current_exception();
+                }
+            };
+
+    auto chunk = proc.memory_chunk_size();
+    for (auto & pw : pending)
+    {
+        if (!pw.expression.empty())
+        {
+            _interpreter.pipeline("-data-evaluate-expression " + escape_cstring(pw.expression),
+                    [](const result_output & rc)
+                    {
+                        if (rc.class_ == result_class::error)
+                            BOOST_THROW_EXCEPTION( exception(parse_result<error_>(rc.results)) );
+                        if (rc.class_ != result_class::done)
+                            BOOST_THROW_EXCEPTION( unexpected_result_class(result_class::done, rc.class_) );
+                    });
+            continue;
+        }
+
+        if (auto direct = _direct_memory(pw.addr, pw.data.size()))
+        {
+            flush_pipeline(); //the assignments before might touch the same memory.
+            if (direct->write(pw.addr, pw.data))
+                continue;
+        }
+
+        if ((chunk != 0u) && (pw.data.size() > chunk))
+        {
+            flush_pipeline();
+            try
+            {
+                _interpreter.data_write_memory_bytes(pw.addr, pw.data.data(), pw.data.size(), chunk);
+            }
+            catch (...)
+            {
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+        else
+        {
+            std::string cmd = "-data-write-memory-bytes " + std::to_string(pw.addr) + " ";
+            auto pos = cmd.size();
+            cmd.resize(pos + pw.data.size() * 2);
+            hex_encode(pw.data.data(), pw.data.size(), &cmd[pos]);
+            _interpreter.pipeline(cmd);
+        }
+    }
+    flush_pipeline();
     proc.reset_timer();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+bool frame_impl::_overlaps_pending(std::uint64_t addr, std::uint64_t size) const
+{
+    //an assignment might change any memory.
+    return std::any_of(_pending.begin(), _pending.end(),
+                       [&](const pending_write & pw)
+                       {
+                           return !pw.expression.empty() ||
+                                   ((pw.addr < addr + size) && (addr < pw.addr + pw.data.size()));
+                       });
 }
 
 boost::optional<mw::debug::var> frame_impl::call(const std::string & cl)
 {
+    flush();
+    _cache.invalidate(); //the function might change anything
     auto val = _interpreter.data_evaluate_expression(cl);
     if (val == "void")
         return boost::none;
@@ -232,12 +332,8 @@ boost::optional<mw::debug::var> frame_impl::call(const std::string & cl)
     return vr;
 }
 
-std::size_t frame_impl::get_size(const std::string pt)
+static std::size_t parse_size(const std::string & pt, const std::string & size_st)
 {
-    //ok, we need to check if it's a variable first
-    std::string size_st = _interpreter.data_evaluate_expression("sizeof(" + pt + ")");
-    proc.reset_timer();
-
     try {
         return std::stoull(size_st);
 
@@ -254,50 +350,113 @@ std::size_t frame_impl::get_size(const std::string pt)
     return 0u;
 }
 
+std::size_t frame_impl::get_size(const std::string pt)
+{
+    //ok, we need to check if it's a variable first
+    std::string size_st = _interpreter.data_evaluate_expression("sizeof(" + pt + ")");
+    proc.reset_timer();
+    return parse_size(pt, size_st);
+}
+
+void frame_impl::_evaluate(const std::string & expr, boost::optional<std::string> & value)
+{
+    _interpreter.pipeline("-data-evaluate-expression " + escape_cstring(expr),
+            [&value](const result_output & rc)
+            {
+                if (rc.class_ == result_class::done)
+                    value = find(rc.results, key::value).as_string();
+            });
+}
+
+//write the bits of the byte msb first as '0' & '1', all eight at once.
+static void bits_to_chars(std::uint8_t byte, char * out)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    constexpr std::uint64_t select = 0x8040201008040201ull;
+#else
+    constexpr std::uint64_t select = 0x0102040810204080ull;
+#endif
+    //every byte of the product holds the whole value, the mask leaves the bit for its position, which the add moves to bit 7.
+    auto bits = (byte * 0x0101010101010101ull) & select;
+    bits = ((bits + 0x7F7F7F7F7F7F7F7Full) >> 7) & 0x0101010101010101ull;
+    bits |= 0x3030303030303030ull; //'0' + bit
+    std::memcpy(out, &bits, 8u);
+}
 
 mw::debug::var frame_impl::print(const std::string & pt, bool bitwise)
 {
+    flush();
     mw::debug::var ref_val;
 
     auto is_var =
         [](const std::string & pt)
         {
-            regex rx{"[^A-Za-z_]\\w*"};
+            static const regex rx{"[^A-Za-z_]\\w*"};
             return regex_match(pt, rx);
         };
 
     if (bitwise && !is_var(pt))
     {
         try {
-            auto size = get_size(pt);
-            auto addr = _interpreter.data_evaluate_expression("&" + pt);
-            //addr might be inside ""
-            auto idx = addr.find(' ');
+            //the size of the expression is requested in the same round trip as the address, unless it's known already.
+            auto & sizes = proc.type_size_cache();
+            auto cached  = sizes.find(pt);
+
+            boost::optional<std::string> addr_st, size_st;
+            _evaluate("&" + pt, addr_st);
+            if (cached == sizes.end())
+                _evaluate("sizeof(" + pt + ")", size_st);
+            _interpreter.flush();
+
+            if (!addr_st)
+                BOOST_THROW_EXCEPTION( unexpected_result_class(result_class::done, result_class::error) );
+
+            //addr might be inside "", or have the type in front, e.g. "(int *) 0x601040 <x>"
+            auto addr = *addr_st;
+            std::string type;
+            if (!addr.empty() && (addr.front() == '('))
+            {
+                int depth = 0;
+                auto itr = std::find_if(addr.begin(), addr.end(),
+                                [&](char c)
+                                {
+                                    depth += (c == '(') ? 1 : (c == ')') ? -1 : 0;
+                                    return depth == 0;
+                                });
+                if (itr != addr.end())
+                    type.assign(addr.begin(), itr + 1);
+            }
+
+            auto idx = addr.find("0x");
+            if (idx != std::string::npos)
+                addr = addr.substr(idx);
+            idx = addr.find(' ');
             if (idx != std::string::npos)
                 addr = addr.substr(0, idx);
 
-            auto vv  = _interpreter.data_read_memory_bytes(addr, size);
-            auto & val = vv.at(0);
+            //the same expression can have another type in another scope, so the cache only holds if the type matches.
+            std::size_t size;
+            if ((cached != sizes.end()) && !type.empty() && (cached->second.type == type))
+                size = cached->second.size;
+            else if (size_st)
+                size = parse_size(pt, *size_st);
+            else
+                size = get_size(pt);
 
-            ref_val.ref = val.begin + val.offset;
-            ref_val.value.reserve(val.contents.size() * 8);
+            if (!type.empty())
+                sizes[pt] = process::type_size{type, size};
 
-            auto bit_to_str =
-                    [](char c, int pos)
-                    {
-                        return ((c >> pos) & 0b1) ? '1' : '0';
-                    };
+            auto address  = std::stoull(addr, nullptr, 0);
+            auto contents = read_memory(address, size);
+
+            ref_val.ref = address;
+            ref_val.value.resize(contents.size() * 8);
 
-            for (auto & v : boost::make_iterator_range(val.contents.rbegin(), val.contents.rend()))
+            auto out = &ref_val.value[0];
+            for (auto & v : boost::make_iterator_range(contents.rbegin(), contents.rend()))
             {
-                ref_val.value.push_back(bit_to_str(v, 7));
-                ref_val.value.push_back(bit_to_str(v, 6));
-                ref_val.value.push_back(bit_to_str(v, 5));
-                ref_val.value.push_back(bit_to_str(v, 4));
-                ref_val.value.push_back(bit_to_str(v, 3));
-                ref_val.value.push_back(bit_to_str(v, 2));
-                ref_val.value.push_back(bit_to_str(v, 1));
-                ref_val.value.push_back(bit_to_str(v, 0));
+                bits_to_chars(v, out);
+                out += 8;
             }
             proc.reset_timer();
 
@@ -308,7 +467,19 @@ mw::debug::var frame_impl::print(const std::string & pt, bool bitwise)
         }
     }
 
-    auto val = _interpreter.data_evaluate_expression(pt);
+    //the size is only needed for the bitwise output, so it's requested with the value.
+    std::string val;
+    boost::optional<std::string> size_st;
+    if (bitwise)
+    {
+        boost::optional<std::string> value;
+        _evaluate(pt, value);
+        _evaluate("sizeof(" + pt + ")", size_st);
+        _interpreter.flush();
+        val = value ? *value : _interpreter.data_evaluate_expression(pt); //let it report the error.
+    }
+    else
+        val = _interpreter.data_evaluate_expression(pt);
 
     std::uint64_t ref_value;
     pegtl::memory_input<> mi{val, "gdb mi2, value parse"};
@@ -336,7 +507,7 @@ mw::debug::var frame_impl::print(const std::string & pt, bool bitwise)
     if (bitwise //turn the int into a binary.
         && !((ref_val.value.front() == '<') && (ref_val.value.back() == '>'))) //if it's not meta information e.g. <optimized out>
     {
-        auto size = get_size(pt);
+        auto size = size_st ? parse_size(pt, *size_st) : get_size(pt);
         std::size_t val = 0u;
         
         
@@ -352,41 +523,20 @@ mw::debug::var frame_impl::print(const std::string & pt, bool bitwise)
             BOOST_THROW_EXCEPTION(parser_error("stoull[print, bitwise] - out of range '" + ref_val.value + "'"));
         }
 
-        std::string res;
-        res.reserve(size*8);
-
-        auto bit_to_str =
-                [](std::uint64_t c, std::uint64_t pos)
-                {
-                    return ((c >> pos) & 0b1ull) ? '1' : '0';
-                };
-
-        bool first = true;
-        auto push_back = [&](char c)
-        {
-            if ((c == '0') && first)
-                return;
-            else
-            {
-                first = false;
-                res.push_back(c);
-            }
-        };
-
-        for (auto i = size; i != 0; )
+        std::string res(size * 8, '0');
+        for (std::size_t i = 0u; i < size; i++)
         {
-            i--;
-            push_back(bit_to_str(val, 7 + (i * 8)));
-            push_back(bit_to_str(val, 6 + (i * 8)));
-            push_back(bit_to_str(val, 5 + (i * 8)));
-            push_back(bit_to_str(val, 4 + (i * 8)));
-            push_back(bit_to_str(val, 3 + (i * 8)));
-            push_back(bit_to_str(val, 2 + (i * 8)));
-            push_back(bit_to_str(val, 1 + (i * 8)));
-            push_back(bit_to_str(val, 0 + (i * 8)));
+            auto shift = (size - 1 - i) * 8;
+            if (shift < 64u)
+                bits_to_chars(static_cast<std::uint8_t>(val >> shift), &res[i * 8]);
         }
-        if (res.empty())
+
+        //leading zeros are dropped.
+        auto first = res.find('1');
+        if (first == std::string::npos)
             res = "0";
+        else
+            res.erase(0, first);
         ref_val.value = res;
 
     }
@@ -414,8 +564,35 @@ mw::debug::var parse_var(interpreter & interpreter_,  const std::string & id, st
     return ref_val;
 }
 
+void frame_impl::_resolve_arg(std::size_t index) const
+{
+    if ((index >= _raw_args.size()) || !_raw_args[index])
+        return;
+
+    //a reference is resolved by evaluating the argument, which must happen in the frame of the breakpoint
+    //and must see the writes done so far.
+    const_cast<frame_impl&>(*this).flush();
+    auto & as = _arg_list[index];
+    if (_selected != 0)
+        _interpreter.stack_select_frame(0);
+    auto arg = parse_var(_interpreter, as.id, *_raw_args[index]);
+    if (_selected != 0)
+        _interpreter.stack_select_frame(_selected);
+    proc.reset_timer();
+
+    as.ref     = arg.ref;
+    as.value   = arg.value;
+    as.cstring = arg.cstring;
+    _raw_args[index] = boost::none;
+}
+
 void frame_impl::return_(const std::string & value)
 {
+    //the arguments can't be evaluated anymore once the frame of the breakpoint is popped.
+    for (std::size_t idx = 0u; idx < _raw_args.size(); idx++)
+        _resolve_arg(idx);
+    flush();
+    _cache.invalidate();
     _interpreter.exec_return(value);
     proc.reset_timer();
 }
@@ -427,12 +604,15 @@ void frame_impl::set_exit(int code)
 
 void frame_impl::select(int frame)
 {
+    flush(); //the assignments refer to the current frame
     _interpreter.stack_select_frame(frame);
+    _selected = frame;
     proc.reset_timer();
 }
 
 std::vector<mw::debug::backtrace_elem> frame_impl::backtrace()
 {
+    flush();
     auto bt = _interpreter.stack_list_frames();
     proc.reset_timer();
 
@@ -518,32 +698,182 @@ boost::optional<mw::debug::address_info> frame_impl::addr2line(std::uint64_t add
 
 void frame_impl::disable(const mw::debug::break_point & bp)
 {
-    const auto & bps = proc.break_point_map();
-
-    auto itr = std::find_if(bps.begin(), bps.end(), [&](const std::pair<int, break_point*> & bp_p){return bp_p.second == &bp;});
-    if (itr == bps.end())
+    auto & numbers = proc.break_point_numbers(bp);
+    if (numbers.empty())
         return ; //should not happen
 
-    int num = itr->first;
-    _interpreter.break_disable(num);
+    _interpreter.break_disable(numbers);
     proc.reset_timer();
 }
 
 void frame_impl::enable (const mw::debug::break_point & bp)
 {
-    const auto & bps = proc.break_point_map();
-
-    auto itr = std::find_if(bps.begin(), bps.end(), [&](const std::pair<int, break_point*> & bp_p){return bp_p.second == &bp;});
-    if (itr == bps.end())
+    auto & numbers = proc.break_point_numbers(bp);
+    if (numbers.empty())
         return ; //should not happen
 
-    int num = itr->first;
-    _interpreter.break_enable(num);
+    _interpreter.break_enable(numbers);
     proc.reset_timer();
 }
 
 std::vector<std::uint8_t> frame_impl::read_memory(std::uint64_t addr, std::size_t size)
 {
+    if (_overlaps_pending(addr, size))
+        flush();
+
+    //large regions are not kept in the cache.
+    auto chunk = proc.memory_chunk_size();
+    auto data = (((chunk != 0u) && (size > chunk)) || !_cacheable(addr, size)) ?
+                    _read_memory(addr, size) :
+                    _cache.read(addr, size,
+                               [this](std::uint64_t addr, std::size_t size)
+                               {
+                                   return _read_memory(addr, size);
+                               });
+
+    //a partially readable chunk is returned shortened, but there has to be something.
+    if (data.empty() && (size != 0u))
+    {
+        std::ostringstream ss;
+        ss << "Cannot access memory at address 0x" << std::hex << addr;
+        BOOST_THROW_EXCEPTION( exception(error_{ss.str(), boost::none}) );
+    }
+    return data;
+}
+
+std::uint64_t frame_impl::read_memory(std::uint64_t addr, std::uint64_t size,
+                                      const std::function<void(std::uint64_t, const std::uint8_t *, std::size_t)> & sink)
+{
+    if (_overlaps_pending(addr, size))
+        flush();
+
+    size = _memory_map().readable(addr, size);
+    if (size == 0u)
+        return 0u;
+
+    auto chunk = proc.memory_chunk_size();
+    auto step  = chunk != 0u ? static_cast<std::uint64_t>(chunk) : size;
+
+    //this can take a while, so every chunk counts as progress.
+    auto fwd = [&](std::uint64_t address, const std::uint8_t * data, std::size_t len)
+               {
+                   sink(address, data, len);
+                   proc.reset_timer();
+               };
+
+    std::uint64_t done = 0u;
+    if (proc.direct_memory())
+    {
+        std::vector<std::uint8_t> buffer;
+        while (done < size)
+        {
+            auto len = static_cast<std::size_t>((std::min)(step, size - done));
+            auto direct = _direct_memory(addr + done, len);
+            if (!direct || !direct->read(addr + done, len, buffer))
+                break;
+            fwd(addr + done, buffer.data(), len);
+            done += len;
+        }
+    }
+
+    if (done == 0u)
+        return _interpreter.data_read_memory_bytes(addr, size, chunk, fwd);
+
+    try
+    {
+        if (done < size)
+            done += _interpreter.data_read_memory_bytes(addr + done, size - done, chunk, fwd);
+    }
+    catch (mi2::exception &) //the rest is not readable.
+    {
+    }
+    return done;
+}
+
+bool frame_impl::_cacheable(std::uint64_t addr, std::size_t size)
+{
+    if (!_cache.enabled() || (size == 0u))
+        return false;
+
+    //without a map the memory of a remote target might as well be a peripheral register.
+    auto & mp = _memory_map();
+    if (mp.empty())
+        return proc.is_local();
+
+    std::uint64_t page_size = _cache.page_size();
+    auto first = addr / page_size;
+    auto last  = (addr + size - 1u) / page_size + _cache.read_ahead();
+    return mp.cacheable(first * page_size, (last - first + 1u) * page_size);
+}
+
+const memory_map & frame_impl::_memory_map()
+{
+    if (proc.direct_memory() && proc.use_memory_map())
+        return _proc_maps();
+    return proc.target_memory_map(_interpreter);
+}
+
+const memory_map & frame_impl::_proc_maps()
+{
+    //the mappings of a local process change while it runs, but reading them is cheap. Only used with direct memory access.
+    if (!_local_map)
+    {
+        std::ifstream fs{"/proc/" + std::to_string(proc.direct_memory()->pid()) + "/maps"};
+        _local_map = memory_map::from_proc_maps(fs);
+    }
+    return *_local_map;
+}
+
+proc_memory * frame_impl::_direct_memory(std::uint64_t addr, std::uint64_t size)
+{
+    //gdb keeps the original code under a software breakpoint in a shadow copy, which /proc/<pid>/mem doesn't know about.
+    //so a read would return the trap instruction and a write be undone when gdb removes the breakpoint.
+    auto direct = proc.direct_memory();
+    if (!direct || proc.overlaps_break_point(addr, size))
+        return nullptr;
+
+    //gdb also inserts breakpoints of its own, which can only be in code. Without the mappings, nothing is known to be safe.
+    auto & mp = _proc_maps();
+    if (mp.empty() || mp.executable(addr, size))
+        return nullptr;
+    return direct;
+}
+
+std::vector<std::uint8_t> frame_impl::_read_memory(std::uint64_t addr, std::size_t size)
+{
+    //unmapped memory is rejected locally and the rest split at the region boundaries, so gdb never reports an error for it.
+    auto segments = _memory_map().segments(addr, size);
+    if (segments.size() == 1u)
+        return _read_segment(segments.front().first, static_cast<std::size_t>(segments.front().second));
+
+    std::vector<std::uint8_t> vec;
+    for (auto & seg : segments)
+    {
+        auto part = _read_segment(seg.first, static_cast<std::size_t>(seg.second));
+        vec.insert(vec.end(), part.begin(), part.end());
+        if (part.size() < seg.second)
+            break;
+    }
+    return vec;
+}
+
+std::vector<std::uint8_t> frame_impl::_read_segment(std::uint64_t addr, std::size_t size)
+{
+    if (auto direct = _direct_memory(addr, size))
+    {
+        std::vector<std::uint8_t> vec;
+        if (direct->read(addr, size, vec))
+            return vec;
+    }
+
+    auto chunk = proc.memory_chunk_size();
+    if ((chunk != 0u) && (size > chunk))
+    {
+        std::vector<std::uint8_t> vec(size);
+        vec.resize(_interpreter.data_read_memory_bytes(addr, size, vec.data(), chunk));
+        return vec;
+    }
+
     auto data = _interpreter.data_read_memory_bytes(std::to_string(addr), size);
 
     std::vector<std::uint8_t> vec;
@@ -559,9 +889,94 @@ std::vector<std::uint8_t> frame_impl::read_memory(std::uint64_t addr, std::size_
     return vec;
 }
 
+std::uint64_t frame_impl::dump_memory(std::uint64_t addr, std::uint64_t size, const std::string & file, bool sparse)
+{
+    memory_dump dump{file, addr, size, sparse};
+    std::uint64_t done = 0u;
+    try
+    {
+        done = read_memory(addr, size,
+                    [&](std::uint64_t address, const std::uint8_t * data, std::size_t len)
+                    {
+                        dump.write(address, data, len);
+                    });
+    }
+    catch (interpreter_error & ie)
+    {
+        _log << "Memory at 0x" << std::hex << addr << std::dec << " not readable: " << ie.what() << std::endl;
+    }
+    dump.finish(done);
+    return done;
+}
+
+std::vector<std::uint8_t> frame_impl::_read_watched(std::uint64_t addr, std::uint64_t size)
+{
+    std::vector<std::uint8_t> data;
+    data.reserve(static_cast<std::size_t>(size));
+    try
+    {
+        read_memory(addr, size,
+                    [&](std::uint64_t, const std::uint8_t * chunk, std::size_t len)
+                    {
+                        data.insert(data.end(), chunk, chunk + len);
+                    });
+    }
+    catch (interpreter_error & ie)
+    {
+        _log << "Watched memory at 0x" << std::hex << addr << std::dec << " not readable: " << ie.what() << std::endl;
+    }
+    return data;
+}
+
+void frame_impl::watch_memory(std::uint64_t addr, std::uint64_t size)
+{
+    proc.watched_memory().watch(addr, size, _read_watched(addr, size));
+}
+
+void frame_impl::unwatch_memory(std::uint64_t addr)
+{
+    proc.watched_memory().unwatch(addr);
+}
+
+std::vector<mw::debug::memory_range> frame_impl::changed_memory(std::uint64_t addr)
+{
+    auto & watched = proc.watched_memory();
+    if (!watched.watched(addr))
+        return {};
+    return watched.update(addr, _read_watched(addr, watched.size(addr)));
+}
+
 void frame_impl::write_memory(std::uint64_t addr, const std::vector<std::uint8_t> &vec)
 {
-    _interpreter.data_write_memory_bytes(std::to_string(addr), vec);
+    _cache.invalidate();
+    if (vec.empty())
+        return;
+
+    pending_write pw;
+    pw.addr = addr;
+    pw.data = vec;
+
+    //merge with the overlapping or adjacent writes since the last assignment, the new data wins.
+    for (auto itr = _pending.end(); itr != _pending.begin(); )
+    {
+        --itr;
+        if (!itr->expression.empty())
+            break;
+
+        auto end_old = itr->addr + itr->data.size();
+        auto end_new = pw.addr + pw.data.size();
+        if ((itr->addr > end_new) || (pw.addr > end_old))
+            continue;
+
+        auto begin = (std::min)(itr->addr, pw.addr);
+        std::vector<std::uint8_t> merged(static_cast<std::size_t>((std::max)(end_old, end_new) - begin));
+        std::copy(itr->data.begin(), itr->data.end(), merged.begin() + (itr->addr - begin));
+        std::copy(pw.data.begin(),   pw.data.end(),   merged.begin() + (pw.addr   - begin));
+        pw.addr = begin;
+        pw.data = std::move(merged);
+        itr = _pending.erase(itr);
+    }
+    _pending.push_back(std::move(pw));
 }
 
 
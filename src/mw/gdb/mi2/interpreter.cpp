@@ -18,15 +18,16 @@
 #include <mw/gdb/mi2/interpreter.hpp>
 #include <mw/gdb/mi2/output.hpp>
 #include <mw/gdb/mi2/input.hpp>
+#include <mw/gdb/mi2/hex.hpp>
 
 
 
 #include <boost/asio/read.hpp>
-#include <boost/asio/read_until.hpp>
 #include <boost/asio/write.hpp>
 
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <cstring>
 #include <istream>
 #include <iostream>
 #include <sstream>
@@ -56,77 +57,150 @@ constexpr bool needs_record()
     return sizeof...(Args) > 0;
 }
 
-template<typename ...Args>
-void interpreter::_work_impl(Args&&...args)
+template<typename Func>
+bool interpreter::_read_block(Func && on_record)
 {
-    if (!_in_buf.empty())
-    {
-        asio::async_write(_in, asio::buffer(_in_buf), _yield);
-        if (_debug)
-            _fwd << _in_buf;
-    }
-    try {
-        asio::async_read_until(_out, _out_buf, "(gdb)", _yield);
-    }
-    catch (boost::system::system_error & se)
+    bool received_record = false;
+    bool received_data   = false;
+    bool eof             = false;
+    bool read_failed     = false;
+
+    //a complete line is parsed directly from the buffer and consumed right away, so handlers may issue further reads.
+    //such a read can overwrite the consumed line, so it must not be used once a handler has been called.
+    auto next_line = [this](boost::string_view & line, bool partial)
+            {
+                auto data = _out_buf.data();
+                auto size = asio::buffer_size(data);
+                if (size == 0u)
+                    return false;
+                auto begin = asio::buffer_cast<const char*>(data);
+                auto nl    = static_cast<const char*>(std::memchr(begin, '\n', size));
+                if (!nl && !partial)
+                    return false;
+                line = boost::string_view(begin, nl ? static_cast<std::size_t>(nl - begin) : size);
+                _out_buf.consume(line.size() + 1);
+                return true;
+            };
+
+    //reads from the pipe until a line is complete, so records are handled while gdb is still writing the rest of the block.
+    auto read_line = [&](boost::string_view & line)
+            {
+                while (!next_line(line, eof))
+                {
+                    if (eof)
+                        return false;
+                    try
+                    {
+                        auto n = _out.async_read_some(_out_buf.prepare(_read_chunk), _yield);
+                        _out_buf.commit(n);
+                        received_data |= (n > 0u);
+                    }
+                    catch (boost::system::system_error & se)
+                    {
+                        //ignore this exception if this was the last valid command
+                        if (!received_data)
+                        {
+                            read_failed = true;
+                            throw;
+                        }
+                        eof = true;
+                    }
+                }
+                return true;
+            };
+
+    //handlers might read another block, so the arena may only be reset by the outermost one.
+    struct depth_guard
     {
-        //ignore this exception if this was the last valid command
-        if (_out_buf.size() == 0)
-            throw;
-    }
+        int & depth;
+        ~depth_guard() {depth--;}
+    } dg{++_read_depth};
 
-    bool received_record = false;
-    constexpr static bool needs_record_ = needs_record<Args...>();
+    if (_read_depth == 1)
+        _arena.reset();
 
-    std::istream out_str(&_out_buf);
-    std::string line;
+    output_line ol{_arena};
+    boost::string_view line;
     try {
-        while (std::getline(out_str, line) && !boost::starts_with(line, "(gdb)"))
+        while (read_line(line) && (parse_line(line, ol) != output_line::prompt))
         {
             if (_debug)
-                _fwd << line ;
-            if (auto data = parse_stream_output(line))
-            {
-                _handle_stream_output(*data);
-                continue;
-            }
+                _fwd << line << '\n';
 
-            if (auto data = parse_async_output(line))
+            switch (ol.type)
             {
-                if (data->first)
+            case output_line::stream:
+                _handle_stream_output(ol.stream_data);
+                break;
+            case output_line::async:
+                if (ol.token)
                 {
-                    if (!_handle_async_output(*data->first, data->second))
-                        BOOST_THROW_EXCEPTION( unexpected_async_record(*data->first, line) );
+                    //checked before a handler can read further and overwrite the line.
+                    if (std::none_of(_pending_asyncs.begin(), _pending_asyncs.end(),
+                                     [&](decltype(_pending_asyncs)::const_reference pa){return pa.first == *ol.token;}))
+                        BOOST_THROW_EXCEPTION( unexpected_async_record(*ol.token, line.to_string()) );
+                    _handle_async_output(*ol.token, ol.async_data);
                 }
-
                 else
-                    _handle_async_output(data->second);
-                continue;
-            }
-
-            if (auto data = parse_record(line))
-            {
-                _handle_record(line, data->first, data->second, std::forward<Args>(args)...);
+                    _handle_async_output(ol.async_data);
+                break;
+            case output_line::result:
+                on_record(line, ol.token, ol.result_data);
                 received_record = true;
-                continue;
+                break;
+            default:
+                if (!_debug)
+                    _fwd << line << '\n';
+                break;
             }
-            else if (!_debug)
-                _fwd << line << '\n';
         }
-
-        if (needs_record_ && !received_record)
-            BOOST_THROW_EXCEPTION( interpreter_error("No record received, even though expected"));
     }
     catch (std::exception & e)
     {
+        if (read_failed)
+            throw;
         _fwd << "***** Interpreter exception ***** : " << e.what() << std::endl;
-        while (std::getline(out_str, line) && !boost::starts_with(line, "(gdb)"))
-            _fwd << line;
+        while (read_line(line) && !line.starts_with("(gdb)"))
+        {
+            _fwd << line << '\n';
+            //the rest of the block is dropped, but a reply in it still belongs to a command, which a pipeline would wait for.
+            try
+            {
+                output_line skipped{_arena};
+                if (parse_line(line, skipped) == output_line::result)
+                    on_record(line, skipped.token, skipped.result_data);
+            }
+            catch (std::exception &)
+            {
+            }
+        }
         _fwd << "(gdb)" << std::endl;
         throw ;
     }
+    return received_record;
 }
 
+template<typename ...Args>
+void interpreter::_work_impl(Args&&...args)
+{
+    if (!_in_buf.empty())
+    {
+        asio::async_write(_in, asio::buffer(_in_buf), _yield);
+        if (_debug)
+            _fwd << _in_buf;
+    }
+
+    constexpr static bool needs_record_ = needs_record<Args...>();
+
+    auto received_record = _read_block(
+            [&](boost::string_view line, const boost::optional<std::uint64_t> & token, const result_output & sr)
+            {
+                _handle_record(line, token, sr, args...);
+            });
+
+    if (needs_record_ && !received_record)
+        BOOST_THROW_EXCEPTION( interpreter_error("No record received, even though expected"));
+}
 
 void interpreter::_work() {_work_impl();}
 void interpreter::_work(std::uint64_t token, result_class rc) { _work_impl(token, rc); }
@@ -143,10 +217,10 @@ async_result interpreter::wait_for_stop()
                 if ((ao.type == async_output::exec) &&
                     (ao.class_ == "stopped"))
                 {
-                    pr.reason  = mi2::find(ao.results, "reason").as_string();
+                    pr.reason  = mi2::find(ao.results, key::reason).as_string();
                     pr.content.resize(ao.results.size() - 1);
                     std::copy_if(ao.results.begin(), ao.results.end(), pr.content.begin(),
-                                    [](const result & r){return r.variable != "reason";});
+                                    [](const result & r){return r.key_ != key::reason;});
                 }
              };
 
@@ -155,11 +229,139 @@ async_result interpreter::wait_for_stop()
     return pr;
 }
 
-void interpreter::_handle_record(const std::string& line, const boost::optional<std::uint64_t> &token, const result_output & sr)
+async_result interpreter::wait_for_stop(breakpoint_hit & hit)
+{
+    async_result pr;
+    _in_buf.clear();
+
+    auto l = [&](const async_output& ao)
+             {
+                if ((ao.type != async_output::exec) || (ao.class_ != "stopped"))
+                    return;
+
+                pr.reason = mi2::find(ao.results, key::reason).as_string();
+                //the hot path, decoded straight from the record without copying it.
+                if ((pr.reason == "breakpoint-hit") && parse_breakpoint_hit(ao.results, hit))
+                    return;
+
+                pr.content.resize(ao.results.size() - 1);
+                std::copy_if(ao.results.begin(), ao.results.end(), pr.content.begin(),
+                                [](const result & r){return r.key_ != key::reason;});
+             };
+
+    boost::signals2::scoped_connection conn = _async_sink.connect(l);
+    _work();
+    return pr;
+}
+
+std::uint64_t interpreter::pipeline(const std::string & command, const std::function<void(const result_output&)> & handler)
 {
-    BOOST_THROW_EXCEPTION( unexpected_record(line) );
+    auto token = _token_gen++;
+    _pipeline.push_back({token, std::to_string(token) + command + '\n', handler});
+    return token;
 }
-void interpreter::_handle_record(const std::string& line, const boost::optional<std::uint64_t> &token, const result_output & sr,
+
+std::uint64_t interpreter::pipeline(const std::string & command, result_class rc)
+{
+    return pipeline(command,
+            [rc](const result_output & sr)
+            {
+                if (sr.class_ == result_class::error)
+                    BOOST_THROW_EXCEPTION( exception(parse_result<error_>(sr.results)) );
+                if ((sr.class_ != rc) || !sr.results.empty())
+                    BOOST_THROW_EXCEPTION( unexpected_result_class(rc, sr.class_) );
+            });
+}
+
+void interpreter::flush()
+{
+    std::exception_ptr ex;
+    //commands in [_pipeline.begin(), _pipeline.begin() + sent) are written to gdb, but not answered yet.
+    std::size_t sent = 0u;
+    std::size_t in_flight = 0u;
+
+    //line is only valid until the handler is called, which might read further.
+    auto on_record =
+            [&](boost::string_view line, const boost::optional<std::uint64_t> & token, const result_output & sr)
+            {
+                //gdb answers in order, so this will almost always be the first one.
+                auto itr = std::find_if(_pipeline.begin(), _pipeline.begin() + sent,
+                                        [&](const pending_command & pc){return token && (pc.token == *token);});
+                if (itr == _pipeline.begin() + sent)
+                {
+                    if (!ex)
+                        ex = std::make_exception_ptr(unexpected_record(line.to_string()));
+                    return;
+                }
+                auto handler = std::move(itr->handler);
+                in_flight -= itr->command.size();
+                _pipeline.erase(itr);
+                sent--;
+                try
+                {
+                    handler(sr);
+                }
+                catch (...)
+                {
+                    if (!ex)
+                        ex = std::current_exception();
+                }
+            };
+
+    try
+    {
+        while (!_pipeline.empty())
+        {
+            //top up the window, but always keep at least one command in flight.
+            _in_buf.clear();
+            while ((sent < _pipeline.size()) &&
+                   ((in_flight == 0u) || (in_flight + _pipeline[sent].command.size() <= _pipeline_window)))
+            {
+                _in_buf   += _pipeline[sent].command;
+                in_flight += _pipeline[sent].command.size();
+                sent++;
+            }
+
+            if (!_in_buf.empty())
+            {
+                asio::async_write(_in, asio::buffer(_in_buf), _yield);
+                if (_debug)
+                    _fwd << _in_buf;
+            }
+            _read_block(on_record);
+        }
+    }
+    catch (...)
+    {
+        //the replies to the commands already written are still coming, so they're read and dropped.
+        //otherwise the next command would get one of them and fail with a mismatched token.
+        _pipeline.erase(_pipeline.begin() + sent, _pipeline.end());
+        for (auto & pc : _pipeline)
+            pc.handler = [](const result_output &){};
+        try
+        {
+            //a block without a record means the output ended.
+            while (!_pipeline.empty() && _read_block(on_record))
+                ;
+        }
+        catch (...) //the connection is broken, there's nothing left to read.
+        {
+        }
+        _pipeline.clear();
+        _in_buf.clear();
+        throw;
+    }
+    _in_buf.clear();
+
+    if (ex)
+        std::rethrow_exception(ex);
+}
+
+void interpreter::_handle_record(boost::string_view line, const boost::optional<std::uint64_t> &token, const result_output & sr)
+{
+    BOOST_THROW_EXCEPTION( unexpected_record(line.to_string()) );
+}
+void interpreter::_handle_record(boost::string_view line, const boost::optional<std::uint64_t> &token, const result_output & sr,
                     std::uint64_t expected_token, result_class rc)
 {
     if (!token)
@@ -177,10 +379,10 @@ void interpreter::_handle_record(const std::string& line, const boost::optional<
     if ((sr.class_ == rc) && sr.results.empty())
         return;
     else
-        BOOST_THROW_EXCEPTION( unexpected_record(line) );
+        BOOST_THROW_EXCEPTION( unexpected_record(line.to_string()) );
 }
 
-void interpreter::_handle_record(const std::string& line, const boost::optional<std::uint64_t> &token, const result_output & sr,
+void interpreter::_handle_record(boost::string_view line, const boost::optional<std::uint64_t> &token, const result_output & sr,
                     std::uint64_t expected_token, const std::function<void(const result_output&)> & func)
 {
 
@@ -346,10 +548,10 @@ breakpoint interpreter::break_info(int number)
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
     try {
-        auto tab  = find(rc.results, "BreakpointTable").as_tuple();
-        auto body = find(tab, "body").as_list().as_results();
+        auto tab  = find(rc.results, key::BreakpointTable).as_tuple();
+        auto body = find(tab, key::body).as_list().as_results();
 
-        auto itr = std::find_if(body.begin(), body.end(), [](const result & r){return r.variable == "bkpt";});
+        auto itr = std::find_if(body.begin(), body.end(), [](const result & r){return r.key_ == key::bkpt;});
         if (itr == body.end())
             BOOST_THROW_EXCEPTION( missing_value("bkpt") );
 
@@ -452,32 +654,46 @@ std::vector<breakpoint> interpreter::break_insert(const address_location & exp,
     return break_insert(loc_for_break(exp), temporary, hardware, pending, disabled, tracepoint, condition, ignore_count, thread_id);
 }
 
-std::vector<breakpoint> interpreter::break_insert(const std::string & location,
+//the -break-insert command without token and newline.
+static std::string break_insert_cmd(const std::string & location,
         bool temporary, bool hardware, bool pending,
         bool disabled, bool tracepoint,
         const boost::optional<std::string> & condition,
         const boost::optional<int> & ignore_count,
         const boost::optional<int> & thread_id)
 {
-    _in_buf = std::to_string(_token_gen) + "-break-insert ";
+    std::string cmd = "-break-insert ";
     if (temporary)
-        _in_buf += "-t ";
+        cmd += "-t ";
     if (hardware)
-        _in_buf += "-h ";
+        cmd += "-h ";
     if (pending)
-        _in_buf += "-f ";
+        cmd += "-f ";
     if (disabled)
-        _in_buf += "-d ";
+        cmd += "-d ";
     if (tracepoint)
-        _in_buf += "-a ";
+        cmd += "-a ";
     if (condition)
-        _in_buf += "-c " + quote_if(*condition) + " ";
+        cmd += "-c " + quote_if(*condition) + " ";
     if (ignore_count)
-        _in_buf += "-i " + std::to_string(*ignore_count) + " ";
+        cmd += "-i " + std::to_string(*ignore_count) + " ";
     if (thread_id)
-        _in_buf += "-p " + std::to_string(*thread_id) + " ";
+        cmd += "-p " + std::to_string(*thread_id) + " ";
 
-    _in_buf += (location + '\n');
+    cmd += location;
+    return cmd;
+}
+
+std::vector<breakpoint> interpreter::break_insert(const std::string & location,
+        bool temporary, bool hardware, bool pending,
+        bool disabled, bool tracepoint,
+        const boost::optional<std::string> & condition,
+        const boost::optional<int> & ignore_count,
+        const boost::optional<int> & thread_id)
+{
+    _in_buf = std::to_string(_token_gen)
+            + break_insert_cmd(location, temporary, hardware, pending, disabled, tracepoint, condition, ignore_count, thread_id)
+            + '\n';
 
     mw::gdb::mi2::result_output rc;
 
@@ -490,15 +706,46 @@ std::vector<breakpoint> interpreter::break_insert(const std::string & location,
     if (rc.class_ != result_class::done)
         _throw_unexpected_result(result_class::done, rc);
 
-    std::vector<breakpoint> bps;
+    return parse_breakpoints(rc.results);
+}
 
-    for (auto & res : rc.results)
+//the reply of a pipelined -break-insert or -dprintf-insert. A reply that can't be decoded is reported like an error,
+//so it only affects this breakpoint and not the whole pipeline.
+static void handle_inserted(const result_output & rc,
+        const std::function<void(std::vector<breakpoint> && bps, const std::string & error)> & handler)
+{
+    if (rc.class_ == result_class::error)
     {
-        if (res.variable == "bkpt")
-            bps.push_back(parse_result<breakpoint>(res.value_.as_tuple()));
+        auto cp = find_if(rc.results, key::msg);
+        handler({}, cp ? cp->as_string() : std::string("error"));
     }
+    else if (rc.class_ == result_class::done)
+    {
+        std::vector<breakpoint> bps;
+        try
+        {
+            bps = parse_breakpoints(rc.results);
+        }
+        catch (interpreter_error & ie)
+        {
+            handler({}, ie.what());
+            return;
+        }
+        handler(std::move(bps), std::string());
+    }
+    else
+        BOOST_THROW_EXCEPTION( unexpected_result_class(result_class::done, rc.class_) );
+}
 
-    return bps;
+std::uint64_t interpreter::pipeline_break_insert(const std::string & location,
+        const std::function<void(std::vector<breakpoint> && bps, const std::string & error)> & handler,
+        const boost::optional<std::string> & condition)
+{
+    return pipeline(break_insert_cmd(location, false, false, false, false, false, condition, boost::none, boost::none),
+            [handler](const result_output & rc)
+            {
+                handle_inserted(rc, handler);
+            });
 }
 
 
@@ -538,37 +785,51 @@ breakpoint interpreter::dprintf_insert(
             temporary, pending, disabled, condition, ignore_count, thread_id);
 }
 
-breakpoint interpreter::dprintf_insert(
-        const std::string & format, const std::vector<std::string> & argument = {},
+//the -dprintf-insert command without token and newline.
+static std::string dprintf_insert_cmd(
+        const std::string & format, const std::vector<std::string> & argument,
         const boost::optional<std::string> & location,
         bool temporary, bool pending, bool disabled,
         const boost::optional<std::string> & condition,
         const boost::optional<int> & ignore_count,
         const boost::optional<int> & thread_id)
 {
-    _in_buf = std::to_string(_token_gen) + "-dprintf-insert ";
+    std::string cmd = "-dprintf-insert ";
     if (temporary)
-        _in_buf += "-t ";
+        cmd += "-t ";
     if (pending)
-        _in_buf += "-f ";
+        cmd += "-f ";
     if (disabled)
-        _in_buf += "-d ";
+        cmd += "-d ";
     if (condition)
-        _in_buf += "-c " + *condition + " ";
+        cmd += "-c " + quote_if(*condition) + " ";
     if (ignore_count)
-        _in_buf += "-i " + std::to_string(*ignore_count) + " ";
+        cmd += "-i " + std::to_string(*ignore_count) + " ";
     if (thread_id)
-        _in_buf += "-p " + std::to_string(*thread_id) + " ";
+        cmd += "-p " + std::to_string(*thread_id) + " ";
 
     if (location)
-        _in_buf += *location + " ";
+        cmd += *location + " ";
 
-    _in_buf += format;
+    cmd += format;
 
     for (auto & arg : argument)
-        _in_buf +=  " " + arg;
+        cmd +=  " " + arg;
 
-    _in_buf += '\n';
+    return cmd;
+}
+
+breakpoint interpreter::dprintf_insert(
+        const std::string & format, const std::vector<std::string> & argument = {},
+        const boost::optional<std::string> & location,
+        bool temporary, bool pending, bool disabled,
+        const boost::optional<std::string> & condition,
+        const boost::optional<int> & ignore_count,
+        const boost::optional<int> & thread_id)
+{
+    _in_buf = std::to_string(_token_gen)
+            + dprintf_insert_cmd(format, argument, location, temporary, pending, disabled, condition, ignore_count, thread_id)
+            + '\n';
 
     mw::gdb::mi2::result_output rc;
     _work(_token_gen++, [&](const mw::gdb::mi2::result_output & rc_in)
@@ -579,7 +840,19 @@ breakpoint interpreter::dprintf_insert(
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return parse_result<breakpoint>(find(rc.results, "bpkt").as_tuple());
+    return parse_result<breakpoint>(find(rc.results, key::bkpt).as_tuple());
+}
+
+std::uint64_t interpreter::pipeline_dprintf_insert(const std::string & location,
+        const std::string & format, const std::vector<std::string> & argument,
+        const std::function<void(std::vector<breakpoint> && bps, const std::string & error)> & handler,
+        const boost::optional<std::string> & condition)
+{
+    return pipeline(dprintf_insert_cmd(format, argument, location, false, false, false, condition, boost::none, boost::none),
+            [handler](const result_output & rc)
+            {
+                handle_inserted(rc, handler);
+            });
 }
 
 
@@ -598,7 +871,7 @@ std::vector<breakpoint> interpreter::break_list()
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    auto body = find(rc.results, "body").as_list().as_results();
+    auto body = find(rc.results, key::body).as_list().as_results();
 
     std::vector<breakpoint> vec;
     vec.resize(body.size());
@@ -606,7 +879,7 @@ std::vector<breakpoint> interpreter::break_list()
     std::transform(body.begin(), body.end(), vec.begin(),
                     [&](const result & rc)
                     {
-                       return parse_result<breakpoint>(find(rc.value_.as_tuple(), "bkpt").as_list().as_results());
+                       return parse_result<breakpoint>(find(rc.value_.as_tuple(), key::bkpt).as_list().as_results());
                     });
     return vec;
 }
@@ -638,7 +911,7 @@ watchpoint interpreter::break_watch(const std::string & expr, bool access, bool
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return parse_result<watchpoint>(find(rc.results, "wpt").as_tuple());
+    return parse_result<watchpoint>(find(rc.results, key::wpt).as_tuple());
 }
 
 breakpoint interpreter::catch_load(const std::string regexp,
@@ -662,7 +935,7 @@ breakpoint interpreter::catch_load(const std::string regexp,
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return parse_result<breakpoint>(find(rc.results, "bkpt").as_tuple());
+    return parse_result<breakpoint>(find(rc.results, key::bkpt).as_tuple());
 }
 
 breakpoint interpreter::catch_unload(const std::string regexp,
@@ -687,7 +960,7 @@ breakpoint interpreter::catch_unload(const std::string regexp,
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return parse_result<breakpoint>(find(rc.results, "bkpt").as_tuple());
+    return parse_result<breakpoint>(find(rc.results, key::bkpt).as_tuple());
 }
 
 breakpoint interpreter::catch_assert(const boost::optional<std::string> & condition, bool temporary, bool disabled)
@@ -712,7 +985,7 @@ breakpoint interpreter::catch_assert(const boost::optional<std::string> & condit
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return parse_result<breakpoint>(find(rc.results, "bkpt").as_tuple());
+    return parse_result<breakpoint>(find(rc.results, key::bkpt).as_tuple());
 }
 
 breakpoint interpreter::catch_exception(const boost::optional<std::string> & condition, bool temporary, bool disabled)
@@ -737,7 +1010,7 @@ breakpoint interpreter::catch_exception(const boost::optional<std::string> & con
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return parse_result<breakpoint>(find(rc.results, "bkpt").as_tuple());
+    return parse_result<breakpoint>(find(rc.results, key::bkpt).as_tuple());
 }
 
 void interpreter::exec_arguments(const std::vector<std::string> & args)
@@ -784,7 +1057,7 @@ std::string interpreter::environment_directory(const std::vector<std::string> &
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return find(rc.results, "source-path").as_string();
+    return find(rc.results, key::source_path).as_string();
 }
 
 std::string interpreter::environment_path(const std::vector<std::string> & path, bool reset)
@@ -811,7 +1084,7 @@ std::string interpreter::environment_path(const std::vector<std::string> & path,
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return find(rc.results, "path").as_string();
+    return find(rc.results, key::path).as_string();
 }
 
 std::string interpreter::environment_pwd()
@@ -828,7 +1101,7 @@ std::string interpreter::environment_pwd()
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return find(rc.results, "cwd").as_string();
+    return find(rc.results, key::cwd).as_string();
 }
 
 
@@ -902,7 +1175,7 @@ std::vector<ada_task_info> interpreter::ada_task_info(const boost::optional<int>
 
    std::vector<struct ada_task_info> infos;
 
-   for (const auto & v : find(rc.results, "body").as_list().as_values())
+   for (const auto & v : find(rc.results, key::body).as_list().as_values())
        infos.push_back(parse_result<struct ada_task_info>(v.as_tuple()));
 
 
@@ -1080,7 +1353,7 @@ frame interpreter::exec_return(const boost::optional<std::string> &val)
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return parse_result<frame>(find(rc.results, "frame").as_tuple());
+    return parse_result<frame>(find(rc.results, key::frame).as_tuple());
 }
 
 void interpreter::exec_run(bool start, bool all)
@@ -1156,7 +1429,7 @@ frame interpreter::stacke_info_frame()
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return parse_result<frame>(find(rc.results, "frame").as_tuple());
+    return parse_result<frame>(find(rc.results, key::frame).as_tuple());
 }
 
 std::size_t interpreter::stack_info_depth()
@@ -1172,7 +1445,7 @@ std::size_t interpreter::stack_info_depth()
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return std::stoull(find(rc.results, "depth").as_string());
+    return std::stoull(find(rc.results, key::depth).as_string());
 }
 
 std::vector<frame> interpreter::stack_list_arguments(
@@ -1206,7 +1479,7 @@ std::vector<frame> interpreter::stack_list_arguments(
        _throw_unexpected_result(result_class::done, rc);
 
     std::vector<frame> fr;
-    auto val = find(rc.results, "stack-args").as_list().as_results();
+    auto val = find(rc.results, key::stack_args).as_list().as_results();
     fr.reserve(val.size());
 
     for (const auto & v : val)
@@ -1238,7 +1511,7 @@ std::vector<frame> interpreter::stack_list_frames(
        _throw_unexpected_result(result_class::done, rc);
 
     std::vector<frame> fr;
-    auto val = find(rc.results, "stack").as_list().as_results();
+    auto val = find(rc.results, key::stack).as_list().as_results();
     fr.reserve(val.size());
 
     for (const auto & v : val)
@@ -1274,13 +1547,13 @@ std::vector<arg> interpreter::stack_list_locals(
        _throw_unexpected_result(result_class::done, rc);
 
 
-    auto lst = find(rc.results, "locals").as_list();
+    auto lst = find(rc.results, key::locals).as_list();
 
     struct visitor_t : boost::static_visitor<>
     {
         std::vector<arg> fr;
 
-        void operator()(const std::vector<result> & res)
+        void operator()(const result_list & res)
         {
             fr.reserve(res.size());
             for (const auto & r : res)
@@ -1291,7 +1564,7 @@ std::vector<arg> interpreter::stack_list_locals(
             }
         }
 
-        void operator()(const std::vector<value> & val)
+        void operator()(const value_list & val)
         {
             fr.reserve(val.size());
             for (const auto & v : val)
@@ -1330,13 +1603,13 @@ std::vector<arg> interpreter::stack_list_variables(
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    auto lst = find(rc.results, "variables").as_list();
+    auto lst = find(rc.results, key::variables).as_list();
 
     struct visitor_t : boost::static_visitor<>
     {
         std::vector<arg> fr;
 
-        void operator()(const std::vector<result> & res)
+        void operator()(const result_list & res)
         {
             fr.reserve(res.size());
             for (const auto & r : res)
@@ -1347,7 +1620,7 @@ std::vector<arg> interpreter::stack_list_variables(
             }
         }
 
-        void operator()(const std::vector<value> & val)
+        void operator()(const value_list & val)
         {
             fr.reserve(val.size());
             for (const auto & v : val)
@@ -1469,7 +1742,7 @@ format_spec interpreter::var_show_format(const std::string & name)
 
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
-    auto var = find(rc.results, "format").as_string();
+    auto var = find(rc.results, key::format).as_string();
 
     if (var == "binary")           return format_spec::binary;
     if (var == "decimal")          return format_spec::decimal;
@@ -1494,7 +1767,7 @@ std::size_t interpreter::var_info_num_children(const std::string & name)
 
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
-    return std::stoull( find(rc.results, "numchild").as_string() );
+    return std::stoull( find(rc.results, key::numchild).as_string() );
 }
 
 std::vector<varobj> interpreter::var_list_children(const std::string & name,
@@ -1524,10 +1797,10 @@ std::vector<varobj> interpreter::var_list_children(const std::string & name,
        _throw_unexpected_result(result_class::done, rc);
 
     std::vector<varobj> vec;
-    vec.reserve(std::stoi(find(rc.results, "numchild").as_string()));
+    vec.reserve(std::stoi(find(rc.results, key::numchild).as_string()));
 
-    for (auto & elem : find(rc.results, "chlidren").as_list().as_values())
-        vec.push_back(parse_result<varobj>(find(elem.as_tuple(), "child").as_tuple()));
+    for (auto & elem : find(rc.results, key::children).as_list().as_values())
+        vec.push_back(parse_result<varobj>(find(elem.as_tuple(), key::child).as_tuple()));
 
     return vec;
 }
@@ -1544,7 +1817,7 @@ std::string interpreter::var_info_type(const std::string & name)
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return find(rc.results, "type").as_string();
+    return find(rc.results, key::type).as_string();
 }
 
 std::pair<std::string, std::string> interpreter::var_info_expression(const std::string & exp)
@@ -1559,7 +1832,7 @@ std::pair<std::string, std::string> interpreter::var_info_expression(const std::
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return std::make_pair(find(rc.results, "lang").as_string(), find(rc.results, "exp").as_string());
+    return std::make_pair(find(rc.results, key::lang).as_string(), find(rc.results, key::exp).as_string());
 }
 
 std::string interpreter::var_info_path_expression(const std::string & name)
@@ -1574,7 +1847,7 @@ std::string interpreter::var_info_path_expression(const std::string & name)
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return find(rc.results, "path_expr").as_string();
+    return find(rc.results, key::path_expr).as_string();
 }
 
 std::vector<std::string> interpreter::var_show_attributes(const std::string & name)
@@ -1591,7 +1864,7 @@ std::vector<std::string> interpreter::var_show_attributes(const std::string & na
        _throw_unexpected_result(result_class::done, rc);
 
     std::vector<std::string> vec;
-    auto in = find(rc.results, "status").as_list().as_values();
+    auto in = find(rc.results, key::status).as_list().as_values();
     vec.resize(in.size());
 
     for (const auto & i : in)
@@ -1620,7 +1893,7 @@ std::string interpreter::var_evaluate_expression(
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return find(rc.results, "value").as_string();
+    return find(rc.results, key::value).as_string();
 }
 
 std::string interpreter::var_assign(const std::string & name, const std::string& expr)
@@ -1636,7 +1909,7 @@ std::string interpreter::var_assign(const std::string & name, const std::string&
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return find(rc.results, "value").as_string();
+    return find(rc.results, key::value).as_string();
 }
 
 
@@ -1666,7 +1939,7 @@ std::vector<varobj_update> interpreter::var_update(
        _throw_unexpected_result(result_class::done, rc);
 
     std::vector<varobj_update> vec;
-    auto in = find(rc.results, "status").as_list().as_values();
+    auto in = find(rc.results, key::status).as_list().as_values();
     vec.resize(in.size());
 
     for (const auto & i : in)
@@ -1718,10 +1991,10 @@ src_and_asm_line interpreter::data_disassemble (disassemble_mode de)
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    auto &asm_insns = find(rc.results, "asm_insns");
+    auto &asm_insns = find(rc.results, key::asm_insns);
 
     if (asm_insns.type() == boost::typeindex::type_id<list>())
-           return parse_result<src_and_asm_line>(find(asm_insns.as_list().as_results(), "src_and_asm_line").as_tuple());
+           return parse_result<src_and_asm_line>(find(asm_insns.as_list().as_results(), key::src_and_asm_line).as_tuple());
     else
     {
         auto in = asm_insns.as_list().as_values();
@@ -1755,13 +2028,13 @@ src_and_asm_line interpreter::data_disassemble (disassemble_mode de, std::size_t
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    auto &asm_insns = find(rc.results, "asm_insns");
+    auto &asm_insns = find(rc.results, key::asm_insns);
 
     if (asm_insns.type() == boost::typeindex::type_id<list>())
     {
         auto & list = asm_insns.as_list();
-        if (list.type() == boost::typeindex::type_id<std::vector<result>>())
-            return parse_result<src_and_asm_line>(find(asm_insns.as_list().as_results(), "src_and_asm_line").as_tuple());
+        if (list.type() == boost::typeindex::type_id<result_list>())
+            return parse_result<src_and_asm_line>(find(asm_insns.as_list().as_results(), key::src_and_asm_line).as_tuple());
         else
             return src_and_asm_line();
     }
@@ -1803,10 +2076,10 @@ src_and_asm_line interpreter::data_disassemble (disassemble_mode de, const std::
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    auto &asm_insns = find(rc.results, "asm_insns");
+    auto &asm_insns = find(rc.results, key::asm_insns);
 
     if (asm_insns.type() == boost::typeindex::type_id<list>())
-           return parse_result<src_and_asm_line>(find(asm_insns.as_list().as_results(), "src_and_asm_line").as_tuple());
+           return parse_result<src_and_asm_line>(find(asm_insns.as_list().as_results(), key::src_and_asm_line).as_tuple());
     else
     {
         auto in = asm_insns.as_list().as_values();
@@ -1837,7 +2110,7 @@ std::string interpreter::data_evaluate_expression(const std::string & expr)
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return find(rc.results, "value").as_string();
+    return find(rc.results, key::value).as_string();
 }
 
 
@@ -1854,7 +2127,7 @@ std::vector<std::string> interpreter::data_list_changed_registers()
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    auto l = find(rc.results, "changed-registers").as_list().as_values();
+    auto l = find(rc.results, key::changed_registers).as_list().as_values();
 
     std::vector<std::string> ret;
     ret.reserve(l.size());
@@ -1877,7 +2150,7 @@ std::vector<std::string> interpreter::data_list_register_names()
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    auto l = find(rc.results, "register-names").as_list().as_values();
+    auto l = find(rc.results, key::register_names).as_list().as_values();
 
     std::vector<std::string> ret;
     ret.reserve(l.size());
@@ -1921,7 +2194,7 @@ std::vector<register_value> interpreter::data_list_register_values(
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    auto l = find(rc.results, "register-values").as_list().as_values();
+    auto l = find(rc.results, key::register_values).as_list().as_values();
 
     std::vector<register_value> ret;
     ret.reserve(l.size());
@@ -1988,7 +2261,7 @@ std::vector<read_memory_bytes> interpreter::data_read_memory_bytes(const std::st
 
     std::vector<read_memory_bytes> vec;
 
-    auto memory = find(rc.results, "memory").as_list().as_values();
+    auto memory = find(rc.results, key::memory).as_list().as_values();
     vec.reserve(memory.size());
 
     for (auto & mem : memory)
@@ -2001,25 +2274,155 @@ std::vector<read_memory_bytes> interpreter::data_read_memory_bytes(const std::st
 
 void interpreter::data_write_memory_bytes(const std::string & address, const std::vector<std::uint8_t> & contents, const boost::optional<std::size_t> & count)
 {
-    _in_buf = std::to_string(_token_gen) + "-data-write-memory-bytes " + address;
-
-    std::stringstream ss;
-    ss << " ";
+    _in_buf = std::to_string(_token_gen) + "-data-write-memory-bytes " + address + " ";
 
-    constexpr static char arr_conv[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
-
-    for (auto & c : contents)
-        ss << arr_conv[(c & 0xF0) >> 4] << arr_conv[c & 0x0F];
+    auto pos = _in_buf.size();
+    _in_buf.resize(pos + contents.size() * 2);
+    hex_encode(contents.data(), contents.size(), &_in_buf[pos]);
 
     if (count)
+    {
+        std::stringstream ss;
         ss << " " << std::hex << *count;
+        _in_buf += ss.str();
+    }
 
-    ss << std::endl;
-    _in_buf += ss.str();
+    _in_buf += '\n';
 
     _work(_token_gen++, result_class::done);
 }
 
+//the addresses of a memory record, malformed ones are reported like the other decoders do.
+static std::uint64_t parse_address(const std::string & str)
+{
+    try
+    {
+        return std::stoull(str, nullptr, 16);
+    }
+    catch (std::invalid_argument &)
+    {
+        BOOST_THROW_EXCEPTION(parser_error("stoull[base:16] - invalid argument '" + str + "'"));
+    }
+    catch (std::out_of_range &)
+    {
+        BOOST_THROW_EXCEPTION(parser_error("stoull[base:16] - out of range '" + str + "'"));
+    }
+    return 0u;
+}
+
+std::uint64_t interpreter::_read_memory_chunked(std::uint64_t address, std::uint64_t count, std::size_t chunk_size,
+                                               const std::function<std::uint8_t*(std::uint64_t, std::size_t)> & dest,
+                                               const std::function<void(std::uint64_t, const std::uint8_t*, std::size_t)> & done)
+{
+    if (chunk_size == 0u)
+        chunk_size = static_cast<std::size_t>(count);
+
+    //the end of the contiguous memory read so far.
+    std::uint64_t expected = address;
+    bool stopped = false;
+    std::exception_ptr error;
+
+    auto on_chunk =
+            [&](std::uint64_t chunk_end, const result_output & rc)
+            {
+                if (stopped)
+                    return;
+
+                if (rc.class_ != result_class::done)
+                {
+                    stopped = true;
+                    if (expected == address)
+                        error = rc.class_ == result_class::error
+                                ? std::make_exception_ptr(exception(parse_result<error_>(rc.results)))
+                                : std::make_exception_ptr(unexpected_result_class(result_class::done, rc.class_));
+                    return;
+                }
+
+                for (auto & mem : find(rc.results, key::memory).as_list().as_values())
+                {
+                    auto & tup = mem.as_tuple();
+                    //begin is absolute, offset is only relative to the requested address.
+                    auto begin    = parse_address(find(tup, key::begin).as_string());
+                    auto & contents = find(tup, key::contents).as_string();
+                    auto size = contents.size() / 2;
+
+                    if ((begin != expected) || (size == 0u)) //a gap, everything behind it is not contiguous.
+                        break;
+
+                    auto ptr = dest(begin, size);
+                    if (((contents.size() % 2u) != 0u) || !hex_decode(contents.data(), size, ptr))
+                        BOOST_THROW_EXCEPTION(parser_error("invalid hex contents at address " + std::to_string(begin)));
+                    done(begin, ptr, size);
+                    expected += size;
+                }
+                if (expected != chunk_end)
+                    stopped = true;
+            };
+
+    auto end = address + count;
+    auto next = address;
+    while (!stopped && (next < end))
+    {
+        for (std::size_t i = 0u; (i < _memory_batch) && (next < end); i++)
+        {
+            auto chunk_end = next + (std::min)(static_cast<std::uint64_t>(chunk_size), end - next);
+            pipeline("-data-read-memory-bytes " + std::to_string(next) + " " + std::to_string(chunk_end - next),
+                     [&on_chunk, chunk_end](const result_output & rc){on_chunk(chunk_end, rc);});
+            next = chunk_end;
+        }
+        flush();
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+
+    return expected - address;
+}
+
+std::size_t interpreter::data_read_memory_bytes(std::uint64_t address, std::size_t count, std::uint8_t * out, std::size_t chunk_size)
+{
+    return static_cast<std::size_t>(
+            _read_memory_chunked(address, count, chunk_size,
+                    [&](std::uint64_t addr, std::size_t) {return out + (addr - address);},
+                    [](std::uint64_t, const std::uint8_t *, std::size_t) {}));
+}
+
+std::uint64_t interpreter::data_read_memory_bytes(std::uint64_t address, std::uint64_t count, std::size_t chunk_size, const memory_sink & sink)
+{
+    std::vector<std::uint8_t> buffer;
+    return _read_memory_chunked(address, count, chunk_size,
+                [&](std::uint64_t, std::size_t size)
+                {
+                    buffer.resize(size);
+                    return buffer.data();
+                },
+                sink);
+}
+
+void interpreter::data_write_memory_bytes(std::uint64_t address, const std::uint8_t * data, std::size_t size, std::size_t chunk_size)
+{
+    if (chunk_size == 0u)
+        chunk_size = size;
+
+    std::size_t pos = 0u;
+    std::string cmd;
+    while (pos < size)
+    {
+        for (std::size_t i = 0u; (i < _memory_batch) && (pos < size); i++)
+        {
+            auto len = (std::min)(chunk_size, size - pos);
+            cmd = "-data-write-memory-bytes " + std::to_string(address + pos) + " ";
+            auto hex_pos = cmd.size();
+            cmd.resize(hex_pos + len * 2);
+            hex_encode(data + pos, len, &cmd[hex_pos]);
+
+            pipeline(cmd);
+            pos += len;
+        }
+        flush();
+    }
+}
+
 boost::optional<found_tracepoint> interpreter::trace_find(boost::none_t)
 {
     _in_buf = std::to_string(_token_gen) + "-trace-find none\n";
@@ -2197,7 +2600,7 @@ std::vector<trace_variable> interpreter::trace_list_variables()
 
     std::vector<trace_variable> vars;
 
-    auto ls = find(rc.results, "body").as_list().as_results();
+    auto ls = find(rc.results, key::body).as_list().as_results();
 
     vars.resize(ls.size());
 
@@ -2260,7 +2663,7 @@ std::vector<symbol_line> interpreter::symbol_list_lines(const std::string & file
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    auto var = find(rc.results, "lines").as_list().as_values();
+    auto var = find(rc.results, key::lines).as_list().as_values();
 
     std::vector<symbol_line> res;
     res.reserve(var.size());
@@ -2313,7 +2716,7 @@ std::vector<source_info> interpreter::file_list_exec_source_files()
      if (rc.class_ != result_class::done)
         _throw_unexpected_result(result_class::done, rc);
 
-     auto var = find(rc.results, "files").as_list().as_values();
+     auto var = find(rc.results, key::files).as_list().as_values();
 
      std::vector<source_info> res;
      res.reserve(var.size());
@@ -2398,7 +2801,7 @@ std::vector<info_ada_exception> interpreter::info_ada_exceptions(const std::stri
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    auto entries = find(rc.results, "body").as_list().as_values();
+    auto entries = find(rc.results, key::body).as_list().as_values();
     std::vector<info_ada_exception> vec;
     vec.reserve(entries.size());
 
@@ -2422,7 +2825,7 @@ bool interpreter::info_gdb_mi_command(const std::string & cmd_name)
        _throw_unexpected_result(result_class::done, rc);
 
 
-    return find(rc.results, "exists").as_string() == "true";
+    return find(rc.results, key::exists).as_string() == "true";
 }
 
 std::vector<std::string> interpreter::list_features()
@@ -2438,7 +2841,7 @@ std::vector<std::string> interpreter::list_features()
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    auto entries = find(rc.results, "result").as_list().as_values();
+    auto entries = find(rc.results, key::result).as_list().as_values();
     std::vector<std::string> vec;
     vec.reserve(entries.size());
 
@@ -2461,7 +2864,7 @@ std::vector<std::string> interpreter::list_target_features()
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    auto entries = find(rc.results, "result").as_list().as_values();
+    auto entries = find(rc.results, key::result).as_list().as_values();
     std::vector<std::string> vec;
     vec.reserve(entries.size());
 
@@ -2493,7 +2896,7 @@ std::string interpreter::gdb_show(const std::string & name)
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return find(rc.results, "value").as_string();
+    return find(rc.results, key::value).as_string();
 
 }
 std::string interpreter::gdb_version()
@@ -2543,11 +2946,11 @@ std::vector<groups> interpreter::list_thread_groups(bool available, boost::optio
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    std::vector<value> res;
+    value_list res;
 
-    if (auto val = find_if(rc.results, "threads"))
+    if (auto val = find_if(rc.results, key::threads))
         res = std::move(val->as_list().as_values());
-    else if (auto val = find_if(rc.results, "groups"))
+    else if (auto val = find_if(rc.results, key::groups))
         res = std::move(val->as_list().as_values());
 
     std::vector<struct groups> vec;
@@ -2586,16 +2989,16 @@ std::vector<std::vector<std::string>> interpreter::info_os(const boost::optional
     std::vector<std::string> titles;
     std::vector<std::string> ids;
     {
-        auto in = find(rc.results, "hdr").as_list().as_values();
+        auto in = find(rc.results, key::hdr).as_list().as_values();
         for (auto & v : in)
         {
             auto tup = v.as_tuple();
-            titles.push_back(find(tup, "col_name").as_string());
-            ids.   push_back(find(tup, "colhdr").as_string());
+            titles.push_back(find(tup, key::col_name).as_string());
+            ids.   push_back(find(tup, key::colhdr).as_string());
         }
     }
 
-    auto body = find(rc.results, "body").as_list().as_values();
+    auto body = find(rc.results, key::body).as_list().as_values();
 
     std::vector<std::vector<std::string>> res;
     res.reserve(body.size() + 1);
@@ -2630,7 +3033,7 @@ std::string interpreter::add_inferior()
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return find(rc.results, "inferior").as_string();
+    return find(rc.results, key::inferior).as_string();
 }
 
 ///Execute the specified command in the given interpreter.
@@ -2660,7 +3063,7 @@ std::string interpreter::inferior_tty_show()
     if (rc.class_ != result_class::done)
        _throw_unexpected_result(result_class::done, rc);
 
-    return find(rc.results, "inferior_tty_terminal").as_string();
+    return find(rc.results, key::inferior_tty_terminal).as_string();
 }
 
 ///Toggle the printing of the wallclock, user and system times for an MI command as a field in its output. This command is to help frontend developers optimize the performance of their code. The default argument is true.
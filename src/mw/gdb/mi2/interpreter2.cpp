@@ -49,7 +49,7 @@ void interpreter::_throw_unexpected_result(result_class rc, const mw::gdb::mi2::
 {
     if (res.class_ == result_class::error)
     {
-        if (auto cp = find_if(res.results, "msg"))
+        if (auto cp = find_if(res.results, key::msg))
             BOOST_THROW_EXCEPTION( unexpected_result_class(result_class::done, res.class_, cp->as_string()));
         else
             BOOST_THROW_EXCEPTION( unexpected_result_class(result_class::done, res.class_));
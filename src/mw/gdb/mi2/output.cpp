@@ -14,7 +14,10 @@
  */
 
 #include <mw/gdb/mi2/output.hpp>
-#include <boost/algorithm/string/replace.hpp>
+#include <mw/gdb/mi2/cstring.hpp>
+#include <cctype>
+#include <limits>
+#include <type_traits>
 #define __assume(Val)
 #include <tao/pegtl.hpp>
 
@@ -29,15 +32,95 @@ namespace mi2
 
 
 
-result::result(const result & rhs) : variable(rhs.variable) {value_ = rhs.value_;}
+result::result(const result & rhs) : variable(rhs.variable), key_(rhs.key_) {value_ = rhs.value_;}
 
 result & result::operator=(const result & rhs)
 {
     variable = rhs.variable;
+    key_     = rhs.key_;
     value_   = rhs.value_;
     return *this;
 }
 
+namespace
+{
+
+constexpr const char * key_strings[] =
+{
+    "",
+#define MW_GDB_MI2_KEY_NAME(Id, Name) Name,
+MW_GDB_MI2_KEYS(MW_GDB_MI2_KEY_NAME)
+#undef MW_GDB_MI2_KEY_NAME
+};
+
+static_assert(sizeof(key_strings) / sizeof(key_strings[0]) == key_count, "key list mismatch");
+
+//open addressing hash table, filled to less than a third, so a lookup is mostly one string compare.
+struct key_table
+{
+    constexpr static std::size_t size = 512u;
+    static_assert(key_count * 3 < size, "key table too small");
+
+    boost::string_view names[key_count];
+    key slots[size] = {};
+
+    static std::uint32_t hash(boost::string_view name)
+    {
+        std::uint32_t h = 2166136261u;
+        for (auto c : name)
+        {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    key_table()
+    {
+        for (std::size_t i = 0u; i < key_count; i++)
+            names[i] = key_strings[i];
+
+        for (std::size_t i = 1u; i < key_count; i++)
+        {
+            auto idx = hash(names[i]) & (size - 1u);
+            while (slots[idx] != key::unknown)
+                idx = (idx + 1u) & (size - 1u);
+            slots[idx] = static_cast<key>(i);
+        }
+    }
+
+    key find(boost::string_view name) const
+    {
+        auto idx = hash(name) & (size - 1u);
+        while (slots[idx] != key::unknown)
+        {
+            if (names[static_cast<std::size_t>(slots[idx])] == name)
+                return slots[idx];
+            idx = (idx + 1u) & (size - 1u);
+        }
+        return key::unknown;
+    }
+};
+
+const key_table & keys()
+{
+    static const key_table kt;
+    return kt;
+}
+
+}
+
+key intern(boost::string_view name)
+{
+    return keys().find(name);
+}
+
+boost::string_view key_name(key k)
+{
+    auto idx = static_cast<std::size_t>(k);
+    return idx < key_count ? keys().names[idx] : boost::string_view();
+}
+
 
 namespace parser
 {
@@ -76,6 +159,35 @@ struct control<member<Rule, Ptr, ptr>> : pegtl::normal<Rule>
     }
 };
 
+//the arena is passed as an additional state, so nested elements can be allocated from it.
+struct arena_state
+{
+    arena * resource;
+};
+
+inline arena * find_arena() {return nullptr;}
+
+template<typename ... States>
+inline arena * find_arena(arena_state & as, States && ...) {return as.resource;}
+
+template<typename State, typename ... States>
+inline arena * find_arena(State &&, States && ... st) {return find_arena(std::forward<States>(st)...);}
+
+template<typename T> struct uses_arena : std::false_type {};
+template<> struct uses_arena<result>      : std::true_type {};
+template<> struct uses_arena<tuple>       : std::true_type {};
+template<> struct uses_arena<result_list> : std::true_type {};
+template<> struct uses_arena<value_list>  : std::true_type {};
+
+template<typename T>
+inline T make_elem(arena * resource, std::true_type) {return T(resource);}
+
+template<typename T>
+inline T make_elem(arena *, std::false_type) {return T();}
+
+template<typename T>
+inline T make_elem(arena * resource) {return make_elem<T>(resource, uses_arena<T>{});}
+
 template<typename Rule>
 struct push_back : Rule {};
 
@@ -83,17 +195,17 @@ template<typename Rule>
 struct control<push_back<Rule>> : pegtl::normal<Rule>
 {
 
-    template<pegtl::apply_mode A, pegtl::rewind_mode M, template< typename ... > class Action, template< typename ... > class Control, typename Input, typename State0, typename ... States>
-    static bool match( Input & in, std::vector<State0> & st0,  States && ... st )
+    template<pegtl::apply_mode A, pegtl::rewind_mode M, template< typename ... > class Action, template< typename ... > class Control, typename Input, typename State0, typename Alloc, typename ... States>
+    static bool match( Input & in, std::vector<State0, Alloc> & st0,  States && ... st )
     {
-        State0 val;
+        State0 val = make_elem<State0>(find_arena(st...));
         auto res = control<Rule>::template match<A, M, Action, Control>(in, val, std::forward<States>(st)...);
         st0.push_back(std::move(val));
         return res;
     }
 
-    template<pegtl::apply_mode A, pegtl::rewind_mode M, template< typename ... > class Action, template< typename ... > class Control, typename Input, typename State0>
-    static bool match( Input & in, std::vector<State0> & st0)
+    template<pegtl::apply_mode A, pegtl::rewind_mode M, template< typename ... > class Action, template< typename ... > class Control, typename Input, typename State0, typename Alloc>
+    static bool match( Input & in, std::vector<State0, Alloc> & st0)
     {
         State0 val;
         auto res = control<Rule>::template match<A, M, Action, Control>(in, val);
@@ -112,7 +224,7 @@ struct control<variant_elem<Rule, Type>> : pegtl::normal<Rule>
     template<pegtl::apply_mode A, pegtl::rewind_mode M, template< typename ... > class Action, template< typename ... > class Control, typename Input, typename State0, typename ... States>
     static bool match( Input & in, State0 & st0,  States && ... st )
     {
-        Type val;
+        Type val = make_elem<Type>(find_arena(st...));
         auto res = control<Rule>::template match<A, M, Action, Control>(in, val, std::forward<States>(st)...);
         st0 = std::move(val);
         return res;
@@ -162,7 +274,27 @@ template<> struct action<async_class_rule>
 };
 
 
-struct cstring : pegtl::seq<pegtl::one<'"'>, pegtl::star<pegtl::sor<pegtl::string<'\\', '"'>, pegtl::not_one<'"'>>>, pegtl::one<'"'>> {};
+//scans for the closing quote in bulk instead of matching char by char.
+struct cstring
+{
+    using analyze_t = pegtl::analysis::generic<pegtl::analysis::rule_type::ANY>;
+
+    template<typename Input>
+    static bool match(Input & in)
+    {
+        auto begin = in.current();
+        auto end   = in.end();
+        if ((begin == end) || (*begin != '"'))
+            return false;
+
+        auto close = scan_cstring(begin + 1, end);
+        if (close == end)
+            return false;
+
+        in.bump_in_this_line(static_cast<std::size_t>(close - begin) + 1u);
+        return true;
+    }
+};
 
 
 template<>
@@ -171,14 +303,7 @@ struct action<cstring>
    template<typename T, typename ...Args>
    static void apply( const T & in , std::string & data, Args&&...)
    {
-       if (in.size() > 2)
-       {
-           data.assign(in.begin() +1, in.end() - 1);
-           boost::replace_all(data, "\\\"", "\"");
-           boost::replace_all(data, "\\\\\"", "\\\"");
-       }
-       else
-           data = "";
+       unescape_cstring(in.begin() + 1, in.end() - 1, data);
    }
 };
 
@@ -232,7 +357,7 @@ struct action<async_output_type>
            data = async_output::status;
        break;
        case '=':
-           data = async_output::status;
+           data = async_output::notify;
        break;
        }
    }
@@ -245,37 +370,33 @@ struct variable : pegtl::plus<pegtl::not_one<'='>> {};
 template<>
 struct action<variable>
 {
-   thread_local static std::string last_var_name; //since a tuple may have unnamed follow-ups.
-   template<typename T>
-   static void apply( const T & in , std::string & data)
-   {
-       data = in.string();
-       last_var_name = in.string();
-   }
    template<typename T, typename ...Args>
-   static void apply( const T & in , std::string & data, Args && ...)
+   static void apply( const T & in , result & data, Args && ...)
    {
-       data = in.string();
-       last_var_name = in.string();
+       data.variable = in.string();
+       data.key_     = intern(data.variable);
    }
 };
 
-thread_local std::string action<variable>::last_var_name = "";
-
-struct inherited_name : pegtl::success {};
+//an unnamed result of a record inherits the name of the one before it, e.g. the locations of a breakpoint.
+template<typename Rule>
+struct push_back_inherited : Rule {};
 
-template<>
-struct action<inherited_name>
+template<typename Rule>
+struct control<push_back_inherited<Rule>> : pegtl::normal<Rule>
 {
-    template<typename T>
-    static void apply(const T& , std::string & data)
+    template<pegtl::apply_mode A, pegtl::rewind_mode M, template< typename ... > class Action, template< typename ... > class Control, typename Input, typename Alloc, typename ... States>
+    static bool match( Input & in, std::vector<result, Alloc> & st0,  States && ... st )
     {
-        data = action<variable>::last_var_name;
-    }
-    template<typename T, typename ...Args>
-    static void apply(const T& , std::string & data, Args && ...)
-    {
-        data = action<variable>::last_var_name;
+        result val = make_elem<result>(find_arena(st...));
+        if (!st0.empty())
+        {
+            val.variable = st0.back().variable;
+            val.key_     = st0.back().key_;
+        }
+        auto res = control<Rule>::template match<A, M, Action, Control>(in, val, std::forward<States>(st)...);
+        st0.push_back(std::move(val));
+        return res;
     }
 };
 
@@ -286,27 +407,19 @@ struct unique_ptr : Rule {};
 
 template<typename Rule> struct control<unique_ptr<Rule>> : pegtl::normal<Rule>
 {
-    template<pegtl::apply_mode A, pegtl::rewind_mode M, template< typename ... > class Action, template< typename ... > class Control, typename Input, typename State0, typename ... States>
-    static bool match( Input & in, std::unique_ptr<State0> & st0,  States && ... st )
+    template<pegtl::apply_mode A, pegtl::rewind_mode M, template< typename ... > class Action, template< typename ... > class Control, typename Input, typename ... States>
+    static bool match( Input & in, std::unique_ptr<value, value_deleter> & st0,  States && ... st )
     {
         if (!st0)
-            st0 = std::make_unique<State0>();
+            st0 = make_value(find_arena(st...));
 
         return control<Rule>::template match<A, M, Action, Control>(in, *st0, std::forward<States>(st)...);
     }
-    template<pegtl::apply_mode A, pegtl::rewind_mode M, template< typename ... > class Action, template< typename ... > class Control, typename Input, typename State>
-    static bool match( Input & in, std::unique_ptr<State> & st0)
-    {
-        if (!st0)
-            st0 = std::make_unique<State>();
-
-        return control<Rule>::template match<A, M, Action, Control>(in, *st0);
-    }
 };
 
 
 struct result_rule : pegtl::seq<
-                      member<variable,      decltype(&result::variable), &result::variable>,
+                      variable,
                       pegtl::one<'='>,
                       member<unique_ptr<value_rule>,    decltype(&result::value_p),    &result::value_p>>
 {
@@ -314,7 +427,6 @@ struct result_rule : pegtl::seq<
 
 struct anonym_result_rule :
                 pegtl::seq<
-                    member<inherited_name,          decltype(&result::variable), &result::variable>,
                     member<unique_ptr<value_rule>,  decltype(&result::value_p),&result::value_p>>
 {
 
@@ -325,8 +437,8 @@ struct tuple_rule : pegtl::seq<pegtl::one<'{'> , pegtl::list<push_back<result_ru
 
 struct list_rule : pegtl::sor<
                     pegtl::string<'[', ']'>,
-                    pegtl::seq<pegtl::one<'['>, variant_elem<pegtl::list<push_back<result_rule>, pegtl::one<','>>, std::vector<result>>, pegtl::one<']'>>,
-                    pegtl::seq<pegtl::one<'['>, variant_elem<pegtl::list<push_back<value_rule >, pegtl::one<','>>, std::vector<value >>, pegtl::one<']'>>> {};
+                    pegtl::seq<pegtl::one<'['>, variant_elem<pegtl::list<push_back<result_rule>, pegtl::one<','>>, result_list>, pegtl::one<']'>>,
+                    pegtl::seq<pegtl::one<'['>, variant_elem<pegtl::list<push_back<value_rule >, pegtl::one<','>>, value_list>, pegtl::one<']'>>> {};
 
 struct value_rule : pegtl::sor<
                         variant_elem<cstring, std::string>,
@@ -352,7 +464,7 @@ struct result_record_rule : pegtl::seq<
                                         push_back<result_rule>,
                                         pegtl::star<
                                             pegtl::one<','>,
-                                            push_back<
+                                            push_back_inherited<
                                                 anonym_result_rule
                                                 >
                                         >
@@ -524,6 +636,66 @@ boost::optional<std::pair<boost::optional<std::uint64_t>, result_output>> parse_
         return boost::none;
 }
 
+output_line::type_t parse_line(boost::string_view line, output_line & out)
+{
+    out.token = boost::none;
+    out.type  = output_line::unknown;
+
+    auto itr = line.begin();
+    auto end = line.end();
+
+    if (itr != end && std::isdigit(static_cast<unsigned char>(*itr)))
+    {
+        std::uint64_t tk = 0u;
+        for (; (itr != end) && std::isdigit(static_cast<unsigned char>(*itr)); itr++)
+        {
+            auto digit = static_cast<std::uint64_t>(*itr - '0');
+            if (tk > (std::numeric_limits<std::uint64_t>::max() - digit) / 10u)
+                BOOST_THROW_EXCEPTION(parser_error("token out of range '" + line.to_string() + "'"));
+            tk = tk * 10u + digit;
+        }
+        out.token = tk;
+    }
+
+    if (itr == end)
+        return out.type;
+
+    //the source name is kept short, so it doesn't allocate.
+    pegtl::memory_input<> mi{itr, end, "gdb-mi2"};
+    parser::arena_state as{out.resource};
+
+    switch (*itr)
+    {
+    case '~':
+    case '@':
+    case '&':
+        out.stream_data.content.clear();
+        if (!out.token && pegtl::parse<parser::stream_output, parser::action, parser::control>(mi, out.stream_data))
+            out.type = output_line::stream;
+        break;
+    case '*':
+    case '+':
+    case '=':
+        out.async_data.class_.clear();
+        out.async_data.results.clear();
+        if (pegtl::parse<parser::async_output_rule, parser::action, parser::control>(mi, out.async_data, as))
+            out.type = output_line::async;
+        break;
+    case '^':
+        out.result_data.results.clear();
+        if (pegtl::parse<parser::result_record_rule, parser::action, parser::control>(mi, out.result_data, as))
+            out.type = output_line::result;
+        break;
+    case '(':
+        if (!out.token && line.starts_with("(gdb)"))
+            out.type = output_line::prompt;
+        break;
+    default:
+        break;
+    }
+    return out.type;
+}
+
 std::string to_string(const stream_record & ar)
 {
     std::string ret;
@@ -546,7 +718,7 @@ std::string to_string(const result & res)
     return ret;
 }
 
-std::string to_string(const std::vector<result> & tup)
+std::string to_string(const result_list & tup)
 {
     std::string ret = "{";
 
@@ -599,9 +771,9 @@ std::string to_string(const async_output & ao)
     std::string ret;
     switch (ao.type)
     {
-    case async_output::exec: ret = "*";
-    case async_output::notify: ret = "+";
-    case async_output::status: ret = "=";
+    case async_output::exec:   ret = "*"; break;
+    case async_output::status: ret = "+"; break;
+    case async_output::notify: ret = "="; break;
     }
 
 
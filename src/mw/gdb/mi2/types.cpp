@@ -1,6 +1,9 @@
 #include <mw/gdb/mi2/types.hpp>
-#include <iostream>
-#include <boost/fusion/algorithm/iteration/for_each.hpp>
+#include <mw/gdb/mi2/hex.hpp>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace mw
 {
@@ -25,32 +28,39 @@ inline unsigned long long my_stoull(const std::string & str, std::size_t *pos =
     return 0ull;
 }
 
-template<typename T>
-struct is_vector : std::false_type {};
-
-template<typename T>
-struct is_vector<std::vector<T>> : std::true_type {};
+inline long long my_stoll(const std::string & str, std::size_t *pos = 0, int base = 10)
+{
+    try {
+        return std::stoll(str, pos, base);
+    }
+    catch (std::invalid_argument & ia)
+    {
+        BOOST_THROW_EXCEPTION(parser_error("stoll[base:" + std::to_string(base) + "] - invalid argument '" + str + "'"));
+    }
+    catch (std::out_of_range & oor)
+    {
+        BOOST_THROW_EXCEPTION(parser_error("stoll[base:" + std::to_string(base) + "] - out of range '" + str + "'"));
+    }
+    return 0ll;
+}
 
 template<typename T> struct tag {};
 
-template<typename T> constexpr inline auto reflect(const T& );
-
-
-const value& find(const std::vector<result> & input, const char * id)
+const value& find(const result_list & input, key id)
 {
     auto itr = std::find_if(input.begin(), input.end(),
-                            [&](const result &r){return r.variable == id;});
+                            [&](const result &r){return r.key_ == id;});
 
     if (itr == input.end())
-        BOOST_THROW_EXCEPTION( missing_value(id) );
+        BOOST_THROW_EXCEPTION( missing_value(to_string(id)) );
 
     return itr->value_;
 }
 
-boost::optional<const value&> find_if(const std::vector<result> & input, const char * id)
+boost::optional<const value&> find_if(const result_list & input, key id)
 {
     auto itr = std::find_if(input.begin(), input.end(),
-                            [&](const result &r){return r.variable == id;});
+                            [&](const result &r){return r.key_ == id;});
 
     if (itr == input.end())
         return boost::none;
@@ -58,829 +68,1000 @@ boost::optional<const value&> find_if(const std::vector<result> & input, const c
         return itr->value_;
 }
 
-template<> error_ parse_result(const std::vector<result> &r)
+boost::optional<const value&> find_if(const result_list & input, const char * id)
 {
-    error_ err;
-    err.msg = find(r, "msg").as_string();
+    auto k = intern(id);
+    if (k != key::unknown)
+        return find_if(input, k);
 
-    if (auto code = find_if(r, "code"))
-        err.code = code->as_string();
+    auto itr = std::find_if(input.begin(), input.end(),
+                            [&](const result &r){return r.variable == id;});
 
-    return err;
+    if (itr == input.end())
+        return boost::none;
+    else
+        return itr->value_;
 }
 
-template<> breakpoint parse_result(const std::vector<result> &r)
+const value& find(const result_list & input, const char * id)
 {
-    breakpoint bp;
-
-    bp.number       = std::stoi(find(r, "number").      as_string());
-    bp.type         = find(r, "type").        as_string();
-    bp.disp         = find(r, "disp").        as_string();
-    if (auto cp = find_if(r, "evaluated-by")) bp.evaluated_by = cp->as_string();
-    {
-        auto addr = find(r, "addr").as_string();
-        if (addr != "<MULTIPLE>")
-            bp.addr = my_stoull(addr, 0, 16);
-        else
-            bp.addr = 0;
-    }
-
-    bp.enabled      = find(r, "enabled").as_string() == "y";
-    if (auto cp = find_if(r, "enable")) bp.enable = std::stoi(cp->as_string());
-    bp.times        = std::stoi(find(r, "times"). as_string());
-
-    if (auto cp = find_if(r, "catch-type")) bp.catch_type = cp->as_string();
-    if (auto cp = find_if(r, "func")) bp.func = cp->as_string();
-    if (auto cp = find_if(r, "filename")) bp.filename = cp->as_string();
-    if (auto cp = find_if(r, "fullname")) bp.fullname = cp->as_string();
-
-    if (auto cp = find_if(r, "at")) bp.at = cp->as_string();
-    if (auto cp = find_if(r, "pending")) bp.pending = cp->as_string();
-    if (auto cp = find_if(r, "thread")) bp.thread = cp->as_string();
-    if (auto cp = find_if(r, "task")) bp.task = cp->as_string();
-    if (auto cp = find_if(r, "cond")) bp.cond = cp->as_string();
-    if (auto cp = find_if(r, "traceframe-usage")) bp.traceframe_usage = cp->as_string();
-    if (auto cp = find_if(r, "static-tracepoint-marker-string-id")) bp.static_tracepoint_marker_string_id = cp->as_string();
-    if (auto cp = find_if(r, "mask")) bp.mask = cp->as_string();
-    if (auto cp = find_if(r, "original-location")) bp.original_location = cp->as_string();
-    if (auto cp = find_if(r, "what")) bp.what = cp->as_string();
-
-    if (auto cp = find_if(r, "line"))   bp.line   = std::stoi(cp->as_string());
-    if (auto cp = find_if(r, "ignore")) bp.ignore = std::stoi(cp->as_string());
-    if (auto cp = find_if(r, "pass"))   bp.pass   = std::stoi(cp->as_string());
-    if (auto cp = find_if(r, "installed")) bp.installed = cp->as_string() == "y";
-
-    if (auto cp = find_if(r, "thread-groups"))
-    {
-        const auto &l = cp->as_list().as_values();
-
-        std::vector<std::string> th;
-        th.resize(l.size());
-        std::transform(l.begin(), l.end(),
-                th.begin(),
-                [](const value & v)
-                {
-                    return v.as_string();
-                });
-
-        bp.thread_groups = std::move(th);
+    if (auto val = find_if(input, id))
+        return *val;
+    else
+        BOOST_THROW_EXCEPTION( missing_value(id) );
+}
 
-    }
 
-    return bp;
-}
+namespace
+{
 
+//converters from a value into a member. Optional members are handled by assign,
+//so a converter only needs to accept the plain type.
 
-template<> watchpoint parse_result(const std::vector<result> &r)
+template<typename Conv, typename U>
+auto assign(const Conv & conv, const value & v, U & out, int) -> decltype(conv(v, out), void())
 {
-    watchpoint wp;
-    wp.number = std::stoi(find(r, "number").as_string());
-    wp.exp = find(r, "exp").as_string();
-    return wp;
+    conv(v, out);
 }
 
-template<> arg parse_result(const std::vector<result> & r)
+template<typename Conv, typename U>
+void assign(const Conv & conv, const value & v, boost::optional<U> & out, long)
 {
-    arg a;
-
-    a.name  = find(r, "name").as_string();
-    if (auto val = find_if(r, "value")) a.value = val->as_string();
-    if (auto val = find_if(r,  "type")) a.type = val->as_string();
-
-    return a;
+    U u{};
+    conv(v, u);
+    out = std::move(u);
 }
 
-
-template<> frame parse_result(const std::vector<result> &r)
+struct str_t
 {
-    frame f;
+    void operator()(const value & v, std::string & out) const {out = v.as_string();}
+};
 
-    if (auto val = find_if(r, "level"))
-        f.level = std::stoi(val->as_string());
-    else
-        f.level = 0; //< happends in case of breakpoint hit.
-    if (auto val = find_if(r, "func")) f.func = val->as_string();
-    if (auto val = find_if(r, "addr")) f.addr = my_stoull(find(r, "addr").as_string(), nullptr, 16);
-    if (auto val = find_if(r, "file")) f.file = val->as_string();
-    if (auto val = find_if(r, "line")) f.line = std::stoi(val->as_string());
-    if (auto val = find_if(r, "from")) f.from = val->as_string();
-    if (auto val = find_if(r, "args"))
+template<int Base>
+struct integer_t
+{
+    template<typename U>
+    auto operator()(const value & v, U & out) const -> typename std::enable_if<std::is_integral<U>::value && !std::is_same<U, bool>::value>::type
     {
-        auto & l = val->as_list();
-        if (l.type() == boost::typeindex::type_id<std::vector<value>>())
-        {
-            auto vec = l.as_values();
-            std::vector<arg> args;
-            args.resize(vec.size());
-            std::transform(vec.begin(), vec.end(), args.begin(),
-                        [](const value & rc) -> arg
-                        {
-                            return {find(rc.as_tuple(), "name"). as_string(),
-                                    find(rc.as_tuple(), "value").as_string()};
-                        });
-            f.args = std::move(args);
-        }
-        else //if no value is given.
-        {
-            auto vec = l.as_results();
-            std::vector<arg> args;
-            args.resize(vec.size());
-
-            std::transform(vec.begin(), vec.end(), args.begin(),
-                        [](const result & rc) -> arg
-                        {
-                            return {rc.value_.as_string(), {}};
-                        });
-
-            f.args = std::move(args);
-        }
+        if (std::is_signed<U>::value)
+            out = static_cast<U>(my_stoll(v.as_string(), nullptr, Base));
+        else
+            out = static_cast<U>(my_stoull(v.as_string(), nullptr, Base));
     }
+};
 
-    return f;
-}
+using dec_t = integer_t<10>;
+using hex_t = integer_t<16>;
+using oct_t = integer_t<8>;
 
-template<> thread parse_result(const std::vector<result> &r)
+//a single character marks true, e.g. "y" or "1".
+template<char True>
+struct flag_t
 {
-    thread t;
-    t.id        = std::stoi(find(r, "id").as_string());
-    t.target_id = find(r, "target-id").as_string();
-    if (auto val = find_if(r, "frames"))
+    void operator()(const value & v, bool & out) const
     {
-        auto vec = val->as_list().as_values();
-        std::vector<frame> res;
-        for (auto & v : vec)
-            res.push_back(parse_result<frame>(v.as_tuple()));
-        t.frames = std::move(res);
+        auto & str = v.as_string();
+        out = (str.size() == 1u) && (str.front() == True);
     }
-    t.state     = find(r, "state").as_string();
+};
 
-    return t;
-}
-
-template<> groups parse_result(const std::vector<result> &r)
+//a number, which is true if it's not zero.
+struct nonzero_t
 {
-    groups g;
-
-    g.id = std::stoi(find(r, "id").as_string());
-    g.type = find(r, "type").as_string();
+    void operator()(const value & v, bool & out) const {out = my_stoll(v.as_string()) != 0;}
+};
 
-    if (auto val = find_if(r, "pid"))          g.pid          = std::stoi(val->as_string());
-    if (auto val = find_if(r, "exit_code"))    g.exit_code    = std::stoi(val->as_string());
-    if (auto val = find_if(r, "num_children")) g.num_children = std::stoi(val->as_string());
+//only the presence of the value matters.
+struct present_t
+{
+    void operator()(const value &, bool & out) const {out = true;}
+};
 
-    if (auto val = find_if(r, "threads"))
-    {
-        auto vec = val->as_list().as_values();
-        std::vector<thread> res;
-        for (auto & v : vec)
-            res.push_back(parse_result<thread>(v.as_tuple()));
-        g.threads = std::move(res);
-    }
-    if (auto val = find_if(r, "exit_code"))
+//"true" or "false", anything else (i.e. "invalid") leaves it empty.
+struct true_false_t
+{
+    void operator()(const value & v, boost::optional<bool> & out) const
     {
-        auto vec = val->as_list().as_values();
-        std::vector<int> res;
-        for (auto & v : vec)
-            res.push_back(std::atoi(v.as_string().c_str()));
-        g.cores = std::move(res);
+        auto & str = v.as_string();
+        if (str == "true")
+            out = true;
+        else if (str == "false")
+            out = false;
     }
-    if (auto val = find_if(r, "executable")) g.executable = val->as_string();
+};
 
-    return g;
-}
-
-
-template<> thread_info parse_result(const std::vector<result> &r)
+//thread groups are named "i<num>", though the prefix is omitted by some commands.
+struct group_id_t
 {
-    thread_info ti;
-    ti.id = std::stoi(find(r, "id").as_string());
-    ti.target_id = find(r, "target-id").as_string();
-
-    ti.state = (find(r, "state").as_string() == "stopped") ?
-               thread_info::stopped : thread_info::running;
-
-
-    if (auto val = find_if(r, "details")) ti.details = val->as_string();
-    if (auto val = find_if(r, "core"))    ti.core = std::stoi(val->as_string());
-    if (auto val = find_if(r, "frame"))   ti.frame = parse_result<frame>(val->as_tuple());
-
-    return ti;
-}
+    void operator()(const value & v, int & out) const
+    {
+        auto & str = v.as_string();
+        if (!str.empty() && (str.front() == 'i'))
+            out = static_cast<int>(my_stoll(str.substr(1)));
+        else
+            out = static_cast<int>(my_stoll(str));
+    }
+};
 
-template<> thread_state parse_result(const std::vector<result> & ts)
+//breakpoints with multiple locations or pending ones have "<MULTIPLE>" or "<PENDING>" as address.
+struct bp_addr_t
 {
-    std::vector<thread_info> tis;
+    void operator()(const value & v, std::uint64_t & out) const
     {
-      auto ths = find(ts, "threads").as_list().as_values();
-      tis.resize(ths.size());
-      std::transform(ths.begin(), ths.end(), tis.begin(),
-              [](const value & v)
-              {
-                  return parse_result<thread_info>(v.as_tuple());
-              });
+        auto & str = v.as_string();
+        out = (!str.empty() && (str.front() == '<')) ? 0u : my_stoull(str, nullptr, 16);
     }
-    return {std::move(tis), std::stoi(find(ts, "current-thread-id").as_string())};
-}
+};
 
-template<> thread_id_list parse_result(const std::vector<result> & ts)
+struct hex_bytes_t
 {
-    std::vector<int> tis;
+    void operator()(const value & v, std::vector<std::uint8_t> & out) const
     {
-      auto ths = find(ts, "thread-ids").as_list().as_results();
-      tis.resize(ths.size());
-      std::transform(ths.begin(), ths.end(), tis.begin(),
-              [](const result & r)
-              {
-                  if (r.variable != "thread-id")
-                      BOOST_THROW_EXCEPTION( missing_value("[" + r.variable + " != thread-id]") );
-                  return std::stoi(r.value_.as_string());
-              });
+        auto & ctn = v.as_string();
+        out.resize(ctn.size() / 2);
+        if (((ctn.size() % 2u) != 0u) || !hex_decode(ctn.data(), out.size(), out.data()))
+            BOOST_THROW_EXCEPTION(parser_error("invalid hex contents of " + std::to_string(ctn.size()) + " characters"));
     }
-    return {std::move(tis), std::stoi(find(ts, "current-thread-id").as_string()), std::stoi(find(ts, "number-of-threads").as_string())};
-}
+};
 
-template<> thread_select parse_result(const std::vector<result> & r)
+struct thread_state_t
 {
-    thread_select ts;
-
-    ts.new_thread_id = std::stoi(find(r, "new-thread-id").as_string());
-    if (auto val = find_if(r, "frame")) ts.frame = parse_result<frame>(val->as_tuple());
-    if (auto val = find_if(r, "args"))
+    void operator()(const value & v, thread_info::state_t & out) const
     {
-        auto vec = val->as_list().as_results();
-        std::vector<arg> args;
-        args.resize(vec.size());
-        std::transform(vec.begin(), vec.end(), args.begin(),
-                    [](const result & rc) -> arg
-                    {
-                        return {rc.variable, rc.value_.as_string()};
-                    });
-        ts.args = std::move(args);
+        out = (v.as_string() == "stopped") ? thread_info::stopped : thread_info::running;
     }
-    return ts;
-}
+};
 
-template<> ada_task_info parse_result(const std::vector<result> & r)
+template<typename T>
+struct nested_t
 {
-    ada_task_info ati;
-
-    if (auto val = find_if(r, "current")) ati.current = val->as_string();
-    ati.id =      std::stoi(find(r, "id").as_string());
-    ati.task_id = std::stoi(find(r, "task-id").as_string());
-    if (auto val = find_if(r, "thread-id")) ati.thread_id = std::stoi(val->as_string());
-    if (auto val = find_if(r, "parent-id")) ati.parent_id = std::stoi(val->as_string());
-    ati.priority = std::stoi(find(r, "priority").as_string());
-    ati.state = find(r, "state").as_string();
-    ati.name  = find(r, "name") .as_string();
-
-    return ati;
-}
+    void operator()(const value & v, T & out) const {out = parse_result<T>(v.as_tuple());}
+};
 
-template<> varobj parse_result(const std::vector<result> & r)
+template<typename Conv>
+struct list_of_t
 {
-    varobj ati;
-    ati.name     = find(r, "name").as_string();
-    ati.numchild = std::stoi(find(r, "numchild").as_string());
-    ati.value    = find(r, "value").as_string();
-    ati.type     = find(r, "type").as_string();
-    if (auto val = find_if(r, "thread-id")) ati.thread_id = std::stoi(val->as_string());
-    if (auto val = find_if(r, "has_more"))  ati.has_more = std::stoi(val->as_string()) > 0;
-
-    ati.dynamic = find_if(r, "dynamic").operator bool();
-
-    if (auto val = find_if(r, "displayhint")) ati.displayhint = val->as_string();
-
-    if (auto val = find_if(r, "exp")) ati.exp = val->as_string();
-    ati.frozen = find_if(r, "dynamic").operator bool();
-
-    return ati;
-}
+    Conv conv;
 
+    template<typename U>
+    void operator()(const value & v, std::vector<U> & out) const
+    {
+        auto & vals = v.as_list().as_values();
+        out.clear();
+        out.reserve(vals.size());
+        for (auto & val : vals)
+        {
+            U u{};
+            assign(conv, val, u, 0);
+            out.push_back(std::move(u));
+        }
+    }
+};
 
-template<> varobj_update parse_result(const std::vector<result> & r)
+//the args of a frame are tuples with name & value, or only the names as results if no values were requested.
+struct frame_args_t
 {
-    varobj_update vu;
-    vu.name     = find(r, "name").as_string();
-    vu.value    = find(r, "value").as_string();
-    if (auto val = find_if(r, "in_scope"))
+    void operator()(const value & v, std::vector<arg> & out) const
     {
-        const auto str = val->as_string();
-        if (str == "true")
-            vu.in_scope = true;
-        else if (str == "false")
-            vu.in_scope = false;
+        auto & l = v.as_list();
+        out.clear();
+        if (l.type() == boost::typeindex::type_id<value_list>())
+        {
+            out.reserve(l.as_values().size());
+            for (auto & val : l.as_values())
+                out.push_back(parse_result<arg>(val.as_tuple()));
+        }
+        else
+        {
+            out.reserve(l.as_results().size());
+            for (auto & res : l.as_results())
+                out.push_back(arg{res.value_.as_string(), {}, {}});
+        }
     }
-    if (auto val = find_if(r, "type_changed"))
+};
+
+//args given as name=value results.
+struct named_args_t
+{
+    void operator()(const value & v, std::vector<arg> & out) const
     {
-        const auto str = val->as_string();
-        if (str == "true")
-            vu.type_changed = true;
-        else if (str == "false")
-            vu.type_changed = false;
+        auto & l = v.as_list().as_results();
+        out.clear();
+        out.reserve(l.size());
+        for (auto & res : l)
+            out.push_back(arg{res.variable, res.value_.as_string(), {}});
     }
-    if (auto val = find_if(r, "has_more")) vu.has_more = std::stoi(val->as_string()) > 0;
-    if (auto val = find_if(r, "new_type")) vu.new_type = val->as_string();
-    if (auto val = find_if(r, "new_num_children"))   vu.new_num_children = std::stoi(val->as_string());
-
-    vu.dynamic = find_if(r, "dynamic").operator bool();
+};
 
-    if (auto val = find_if(r, "displayhint")) vu.displayhint = val->as_string();
+//a sequence of thread-id results, either in a tuple or a list.
+struct thread_ids_t
+{
+    void operator()(const value & v, std::vector<int> & out) const
+    {
+        const result_list & l = (v.type() == boost::typeindex::type_id<tuple>()) ?
+                                    static_cast<const result_list&>(v.as_tuple()) : v.as_list().as_results();
+        out.clear();
+        out.reserve(l.size());
+        for (auto & res : l)
+        {
+            if (res.key_ != key::thread_id)
+                BOOST_THROW_EXCEPTION( missing_value("[" + res.variable + " != thread-id]") );
+            out.push_back(static_cast<int>(my_stoll(res.value_.as_string())));
+        }
+    }
+};
+
+constexpr str_t          str{};
+constexpr dec_t          dec{};
+constexpr hex_t          hex{};
+constexpr oct_t          oct{};
+constexpr flag_t<'y'>    yes{};
+constexpr flag_t<'1'>    one{};
+constexpr nonzero_t      nonzero{};
+constexpr present_t      present{};
+constexpr true_false_t   true_false{};
+constexpr group_id_t     group_id{};
+constexpr hex_bytes_t    hex_bytes{};
 
-     vu.dynamic      = static_cast<bool>(find_if(r, "dynamic"));
-     if (auto val = find_if(r, "new_children"))
-     {
-         auto vals = val->as_list().as_values();
-         vu.new_children.clear();
-         vu.new_children.resize(vals.size());
-         for (auto & v : vals)
-             vu.new_children.push_back(v.as_string());
-     }
+template<typename T>
+constexpr nested_t<T> nested() {return {};}
 
-    return vu;
-}
+template<typename Conv>
+constexpr list_of_t<Conv> list_of(Conv conv) {return {conv};}
 
 
-template<> line_asm_insn parse_result(const std::vector<result> & r)
+///Descriptor of a member, which is decoded from the result with the given key.
+template<typename T, typename Member, typename Conv>
+struct field
 {
-    line_asm_insn lai;
+    key key_;
+    Member T::* member;
+    Conv conv;
+    bool required;
+};
 
-    lai.address   = std::stoull(find(r, "address").as_string(), nullptr, 16);
-    lai.func_name = find(r, "func-name").as_string();
-    lai.offset    = std::stoi(find(r, "offset").as_string());
-    lai.inst      = find(r, "inst").as_string();
+template<typename T, typename Member, typename Conv>
+constexpr field<T, Member, Conv> req(key k, Member T::* member, Conv conv) {return {k, member, conv, true};}
 
-    if (auto val = find_if(r, "opcodes"))
-            lai.opcodes = val->as_string();
+template<typename T, typename Member, typename Conv>
+constexpr field<T, Member, Conv> opt(key k, Member T::* member, Conv conv) {return {k, member, conv, false};}
 
-    return lai;
 }
 
-template<> src_and_asm_line parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<error_>)
 {
-    src_and_asm_line lai;
-
-    lai.line     = std::stoi(find(r, "line").as_string());
-    lai.file     = find(r, "file").as_string();
-    if (auto val = find_if(r, "fullname"))
-        lai.fullname = val->as_string();
-
-    if (auto val = find_if(r, "line_asm_insn"))
-    {
-        auto in = val->as_list().as_values();
-
-        std::vector<line_asm_insn> vec;
-        vec.reserve(in.size());
-
-        for (auto & i : in)
-            vec.push_back(parse_result<line_asm_insn>(i.as_tuple()));
-
-        lai.line_asm_insn = std::move(vec);
-    }
-
-    return lai;
+    return std::make_tuple(
+            req(key::msg,  &error_::msg,  str),
+            opt(key::code, &error_::code, str));
 }
 
-template<> register_value parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<breakpoint>)
 {
-    register_value lai;
+    return std::make_tuple(
+            req(key::number,            &breakpoint::number,            dec),
+            req(key::type,              &breakpoint::type,              str),
+            opt(key::catch_type,        &breakpoint::catch_type,        str),
+            req(key::disp,              &breakpoint::disp,              str),
+            req(key::enabled,           &breakpoint::enabled,           yes),
+            req(key::addr,              &breakpoint::addr,              bp_addr_t{}),
+            opt(key::func,              &breakpoint::func,              str),
+            opt(key::filename,          &breakpoint::filename,          str),
+            opt(key::fullname,          &breakpoint::fullname,          str),
+            opt(key::line,              &breakpoint::line,              dec),
+            opt(key::thread_groups,     &breakpoint::thread_groups,     list_of(str)),
+            opt(key::at,                &breakpoint::at,                str),
+            opt(key::pending,           &breakpoint::pending,           str),
+            opt(key::evaluated_by,      &breakpoint::evaluated_by,      str),
+            opt(key::thread,            &breakpoint::thread,            str),
+            opt(key::task,              &breakpoint::task,              str),
+            opt(key::cond,              &breakpoint::cond,              str),
+            opt(key::ignore,            &breakpoint::ignore,            dec),
+            opt(key::enable,            &breakpoint::enable,            dec),
+            opt(key::traceframe_usage,  &breakpoint::traceframe_usage,  str),
+            opt(key::static_tracepoint_marker_string_id, &breakpoint::static_tracepoint_marker_string_id, str),
+            opt(key::mask,              &breakpoint::mask,              str),
+            opt(key::pass,              &breakpoint::pass,              dec),
+            opt(key::original_location, &breakpoint::original_location, str),
+            req(key::times,             &breakpoint::times,             dec),
+            opt(key::installed,         &breakpoint::installed,         yes),
+            opt(key::what,              &breakpoint::what,              str));
+}
 
-    lai.number  = std::stoi(find(r, "number").as_string());
-    lai.value   = find(r, "value").as_string();
+//a further location of a breakpoint with multiple locations, i.e. bkpt={number="2",...},{number="2.1",...}.
+//it has no type, disposition or hit count of its own.
+struct breakpoint_location : breakpoint {};
 
-    return lai;
+constexpr auto reflect(tag<breakpoint_location>)
+{
+    return std::make_tuple(
+            req(key::number,            &breakpoint::number,            dec),
+            req(key::enabled,           &breakpoint::enabled,           yes),
+            req(key::addr,              &breakpoint::addr,              bp_addr_t{}),
+            opt(key::func,              &breakpoint::func,              str),
+            opt(key::filename,          &breakpoint::filename,          str),
+            opt(key::fullname,          &breakpoint::fullname,          str),
+            opt(key::line,              &breakpoint::line,              dec),
+            opt(key::thread_groups,     &breakpoint::thread_groups,     list_of(str)),
+            opt(key::at,                &breakpoint::at,                str),
+            opt(key::original_location, &breakpoint::original_location, str),
+            opt(key::what,              &breakpoint::what,              str));
 }
 
-template<> memory_entry parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<watchpoint>)
 {
-    memory_entry me;
-
-    me.addr  = my_stoull(find(r, "addr").as_string(), nullptr, 16);
-
-    auto data = find(r, "data").as_list().as_values();
-    me.data.resize(data.size());
-
-    for (auto & d : data)
-        me.data.push_back(
-            static_cast<std::uint8_t>(std::stoul(d.as_string(), nullptr, 16)));
-
-    if (auto val = find_if(r, "ascii")) me.ascii = val->as_string();
-
-    return me;
+    return std::make_tuple(
+            req(key::number, &watchpoint::number, dec),
+            req(key::exp,    &watchpoint::exp,    str));
 }
 
-
-template<> read_memory parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<arg>)
 {
-    read_memory rm;
-
-    rm.addr        = my_stoull(find(r, "addr").as_string(), nullptr, 16);
-    rm.nr_bytes    = my_stoull(find(r, "nr-bytes").as_string());
-    rm.total_bytes = my_stoull(find(r, "total-bytes").as_string());
-    rm.next_row    = my_stoull(find(r, "next-row").as_string(), nullptr, 16);
-    rm.prev_row    = my_stoull(find(r, "prev-row").as_string(), nullptr, 16);
-    rm.next_page   = my_stoull(find(r, "next-page").as_string(), nullptr, 16);
-    rm.prev_page   = my_stoull(find(r, "prev-page").as_string(), nullptr, 16);
-
-
-    auto mem = find(r, "memory").as_list().as_values();
-    rm.memory.resize(mem.size());
-
-    for (auto & m : mem)
-        rm.memory.push_back(parse_result<memory_entry>(m.as_tuple()));
-
-    return rm;
+    return std::make_tuple(
+            req(key::name,  &arg::name,  str),
+            opt(key::value, &arg::value, str),
+            opt(key::type,  &arg::type,  str));
 }
 
-template<> read_memory_bytes parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<frame>)
 {
-    read_memory_bytes rm;
-
-    rm.begin  = my_stoull(find(r, "begin").as_string(), nullptr, 16);
-    rm.offset = my_stoull(find(r, "offset").as_string());
-    rm.end    = my_stoull(find(r, "end").as_string());
-
-    auto ctn = find(r, "contents").as_string();
-    rm.contents.resize(ctn.size() /2);
-
-
-    auto to_int = [](char c) -> std::uint8_t
-            {
-                if ((c >= '0' ) && (c <= '9'))
-                    return c - '0';
-
-                if ((c >= 'A' ) && (c <= 'F'))
-                    return c - 'A' + 10;
-
-                if ((c >= 'a' ) && (c <= 'f'))
-                    return c - 'a' + 10;
-
-                return 0;
-            };
-
-    auto itr = ctn.begin();
-    for (auto & c : rm.contents)
-    {
-        c  = to_int(*itr++) << static_cast<std::uint8_t>(4);
-        c |= to_int(*itr++);
-    }
-
-    return rm;
+    return std::make_tuple(
+            opt(key::level, &frame::level, dec), //< not given on a breakpoint hit.
+            opt(key::func,  &frame::func,  str),
+            opt(key::addr,  &frame::addr,  hex),
+            opt(key::file,  &frame::file,  str),
+            opt(key::line,  &frame::line,  dec),
+            opt(key::from,  &frame::from,  str),
+            opt(key::args,  &frame::args,  frame_args_t{}));
 }
 
-
-template <> boost::optional<found_tracepoint> parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<thread>)
 {
-    auto val = find_if(r, "found");
-    if (!val)
-        return boost::none;
-
-    found_tracepoint ft;
-
-    ft.traceframe = std::stoi(find(r, "traceframe").as_string());
-    ft.tracepoint = std::stoi(find(r, "tracepoint").as_string());
-    if (auto val = find_if(r, "frame")) ft.frame = parse_result<frame>(val->as_tuple());
-
-    return ft;
+    return std::make_tuple(
+            req(key::id,        &thread::id,        dec),
+            req(key::target_id, &thread::target_id, str),
+            opt(key::frames,    &thread::frames,    list_of(nested<frame>())),
+            req(key::state,     &thread::state,     str));
 }
 
-template<> memory_region parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<groups>)
 {
-    auto to_int = [](char c) -> std::uint8_t
-            {
-                if ((c >= '0' ) && (c <= '9'))
-                    return c - '0';
-
-                if ((c >= 'A' ) && (c <= 'F'))
-                    return c - 'A' + 10;
-
-                if ((c >= 'a' ) && (c <= 'f'))
-                    return c - 'a' + 10;
-
-                return 0;
-            };
-
-    memory_region mr;
-
-    mr.address  = my_stoull(find(r, "address").as_string(), nullptr, 16);
-    mr.length   = my_stoull(find(r, "value").as_string());
-    if (auto value = find_if(r, "contents"))
-    {
-        auto ctn = value->as_string();
-        mr.contents = std::vector<std::uint8_t>(ctn.size()/2);
-
-        auto itr = ctn.begin();
-        for (auto & c : *mr.contents)
-        {
-            c  = to_int(*itr++);
-            c |= to_int(*itr++) << static_cast<std::uint8_t>(8);
-        }
-    }
-    return mr;
+    return std::make_tuple(
+            req(key::id,           &groups::id,           group_id),
+            req(key::type,         &groups::type,         str),
+            opt(key::pid,          &groups::pid,          dec),
+            opt(key::exit_code,    &groups::exit_code,    oct),
+            opt(key::num_children, &groups::num_children, dec),
+            opt(key::threads,      &groups::threads,      list_of(nested<thread>())),
+            opt(key::cores,        &groups::cores,        list_of(dec)),
+            opt(key::executable,   &groups::executable,   str));
 }
 
-template <> traceframe_collection parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<thread_info>)
 {
-    traceframe_collection tc;
-
-    if (auto val = find_if(r, "explicit-variables"))
-    {
-        auto vec = val->as_list().as_values();
-        tc.explicit_variables.reserve(vec.size());
-        for (auto & ev : vec)
-            tc.explicit_variables.push_back(parse_result<register_value>(ev.as_tuple()));
-    }
+    return std::make_tuple(
+            req(key::id,        &thread_info::id,        dec),
+            req(key::target_id, &thread_info::target_id, str),
+            opt(key::details,   &thread_info::details,   str),
+            req(key::state,     &thread_info::state,     thread_state_t{}),
+            opt(key::core,      &thread_info::core,      dec),
+            opt(key::frame,     &thread_info::frame,     nested<frame>()));
+}
 
-    if (auto val = find_if(r, "computed-expressions"))
-    {
-        auto vec = val->as_list().as_values();
-        tc.computed_expressions.reserve(vec.size());
-        for (auto & ev : vec)
-            tc.computed_expressions.push_back(parse_result<register_value>(ev.as_tuple()));
-    }
+constexpr auto reflect(tag<thread_state>)
+{
+    return std::make_tuple(
+            req(key::threads,           &thread_state::threads,           list_of(nested<thread_info>())),
+            req(key::current_thread_id, &thread_state::current_thread_id, dec));
+}
 
-    if (auto val = find_if(r, "registers"))
-    {
-        auto vec = val->as_list().as_values();
-        tc.registers.reserve(vec.size());
-        for (auto & ev : vec)
-            tc.registers.push_back(parse_result<register_value>(ev.as_tuple()));
-    }
+constexpr auto reflect(tag<thread_id_list>)
+{
+    return std::make_tuple(
+            req(key::thread_ids,        &thread_id_list::thread_ids,        thread_ids_t{}),
+            req(key::current_thread_id, &thread_id_list::current_thread_id, dec),
+            req(key::number_of_threads, &thread_id_list::number_of_threads, dec));
+}
 
-    if (auto val = find_if(r, "tvars"))
-    {
-        auto vec = val->as_list().as_values();
-        tc.tvars.reserve(vec.size());
-        for (auto & ev : vec)
-            tc.tvars.push_back(parse_result<register_value>(ev.as_tuple()));
-    }
+constexpr auto reflect(tag<thread_select>)
+{
+    return std::make_tuple(
+            req(key::new_thread_id, &thread_select::new_thread_id, dec),
+            opt(key::frame,         &thread_select::frame,         nested<frame>()),
+            opt(key::args,          &thread_select::args,          named_args_t{}));
+}
 
-    if (auto val = find_if(r, "tvars"))
-    {
-        auto vec = val->as_list().as_values();
-        tc.memory.reserve(vec.size());
-        for (auto & ev : vec)
-            tc.memory.push_back(parse_result<memory_region>(ev.as_tuple()));
-    }
+constexpr auto reflect(tag<ada_task_info>)
+{
+    return std::make_tuple(
+            opt(key::current,   &ada_task_info::current,   str),
+            req(key::id,        &ada_task_info::id,        dec),
+            req(key::task_id,   &ada_task_info::task_id,   dec),
+            opt(key::thread_id, &ada_task_info::thread_id, dec),
+            opt(key::parent_id, &ada_task_info::parent_id, dec),
+            req(key::priority,  &ada_task_info::priority,  dec),
+            req(key::state,     &ada_task_info::state,     str),
+            req(key::name,      &ada_task_info::name,      str));
+}
 
+constexpr auto reflect(tag<varobj>)
+{
+    return std::make_tuple(
+            req(key::name,        &varobj::name,        str),
+            req(key::numchild,    &varobj::numchild,    dec),
+            req(key::value,       &varobj::value,       str),
+            req(key::type,        &varobj::type,        str),
+            opt(key::thread_id,   &varobj::thread_id,   dec),
+            opt(key::has_more,    &varobj::has_more,    nonzero),
+            opt(key::dynamic,     &varobj::dynamic,     present),
+            opt(key::displayhint, &varobj::displayhint, str),
+            opt(key::exp,         &varobj::exp,         str),
+            opt(key::frozen,      &varobj::frozen,      present));
+}
 
-    return tc;
+constexpr auto reflect(tag<varobj_update>)
+{
+    return std::make_tuple(
+            req(key::name,             &varobj_update::name,             str),
+            req(key::value,            &varobj_update::value,            str),
+            opt(key::in_scope,         &varobj_update::in_scope,         true_false),
+            opt(key::type_changed,     &varobj_update::type_changed,     true_false),
+            opt(key::new_type,         &varobj_update::new_type,         str),
+            opt(key::new_num_children, &varobj_update::new_num_children, dec),
+            opt(key::displayhint,      &varobj_update::displayhint,      str),
+            opt(key::has_more,         &varobj_update::has_more,         nonzero),
+            opt(key::dynamic,          &varobj_update::dynamic,          present),
+            opt(key::new_children,     &varobj_update::new_children,     list_of(str)));
 }
 
-template <> trace_variable parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<line_asm_insn>)
 {
-    trace_variable ft;
+    return std::make_tuple(
+            req(key::address,   &line_asm_insn::address,   hex),
+            req(key::func_name, &line_asm_insn::func_name, str),
+            req(key::offset,    &line_asm_insn::offset,    dec),
+            req(key::inst,      &line_asm_insn::inst,      str),
+            opt(key::opcodes,   &line_asm_insn::opcodes,   str));
+}
 
-    ft.name = my_stoull(find(r, "name").as_string());
-    ft.initial = my_stoull(find(r, "initial").as_string());
-    if (auto val = find_if(r, "current")) ft.current = std::stoll(val->as_string());
+constexpr auto reflect(tag<src_and_asm_line>)
+{
+    return std::make_tuple(
+            req(key::line,          &src_and_asm_line::line,          dec),
+            req(key::file,          &src_and_asm_line::file,          str),
+            opt(key::fullname,      &src_and_asm_line::fullname,      str),
+            opt(key::line_asm_insn, &src_and_asm_line::line_asm_insn, list_of(nested<line_asm_insn>())));
+}
 
-    return ft;
+constexpr auto reflect(tag<register_value>)
+{
+    return std::make_tuple(
+            req(key::number, &register_value::number, dec),
+            req(key::value,  &register_value::value,  str));
 }
 
-template <> trace_status parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<memory_entry>)
 {
-    trace_status ft;
+    return std::make_tuple(
+            req(key::addr,  &memory_entry::addr,  hex),
+            req(key::data,  &memory_entry::data,  list_of(hex)),
+            opt(key::ascii, &memory_entry::ascii, str));
+}
 
-    ft.supported    = find(r, "supported").as_string() == "1";
-    if (auto value = find_if(r, "running")) ft.running = (value->as_string() == "1");
-    if (auto value = find_if(r, "stop-reason")) ft.stop_reason = value->as_string();
-    if (auto value = find_if(r, "stopping-tracepoint")) ft.stopping_tracepoint = std::stoi(value->as_string());
-    if (auto value = find_if(r, "frames")) ft.frames = my_stoull(value->as_string());
-    if (auto value = find_if(r, "frames-created")) ft.frames_created = my_stoull(value->as_string());
-    if (auto value = find_if(r, "buffer-size")) ft.buffer_size = my_stoull(value->as_string());
-    if (auto value = find_if(r, "buffer-free")) ft.buffer_free = my_stoull(value->as_string());
-    if (auto value = find_if(r, "circular"))     ft.circular     = (value->as_string() == "1");
-    if (auto value = find_if(r, "disconnected")) ft.disconnected = (value->as_string() == "1");
-    if (auto value = find_if(r, "trace-file")) ft.trace_file = value->as_string();
+constexpr auto reflect(tag<read_memory>)
+{
+    return std::make_tuple(
+            req(key::addr,        &read_memory::addr,        hex),
+            req(key::nr_bytes,    &read_memory::nr_bytes,    dec),
+            req(key::total_bytes, &read_memory::total_bytes, dec),
+            req(key::next_row,    &read_memory::next_row,    hex),
+            req(key::prev_row,    &read_memory::prev_row,    hex),
+            req(key::next_page,   &read_memory::next_page,   hex),
+            req(key::prev_page,   &read_memory::prev_page,   hex),
+            req(key::memory,      &read_memory::memory,      list_of(nested<memory_entry>())));
+}
 
-    return ft;
+constexpr auto reflect(tag<read_memory_bytes>)
+{
+    return std::make_tuple(
+            req(key::begin,    &read_memory_bytes::begin,    hex),
+            req(key::offset,   &read_memory_bytes::offset,   hex),
+            req(key::end,      &read_memory_bytes::end,      hex),
+            req(key::contents, &read_memory_bytes::contents, hex_bytes));
 }
 
-template <> symbol_line parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<found_tracepoint>)
 {
-    symbol_line sl;
+    return std::make_tuple(
+            req(key::traceframe, &found_tracepoint::traceframe, dec),
+            req(key::tracepoint, &found_tracepoint::tracepoint, dec),
+            opt(key::frame,      &found_tracepoint::frame,      nested<frame>()));
+}
 
-    sl.pc = my_stoull(find(r, "pc").as_string());
-    sl.line = find(r, "line").as_string();
+constexpr auto reflect(tag<memory_region>)
+{
+    return std::make_tuple(
+            req(key::address,  &memory_region::address,  hex),
+            req(key::length,   &memory_region::length,   dec),
+            opt(key::contents, &memory_region::contents, hex_bytes));
+}
 
-    return sl;
+constexpr auto reflect(tag<traceframe_collection>)
+{
+    return std::make_tuple(
+            opt(key::explicit_variables,   &traceframe_collection::explicit_variables,   list_of(nested<register_value>())),
+            opt(key::computed_expressions, &traceframe_collection::computed_expressions, list_of(nested<register_value>())),
+            opt(key::registers,            &traceframe_collection::registers,            list_of(nested<register_value>())),
+            opt(key::tvars,                &traceframe_collection::tvars,                list_of(nested<register_value>())),
+            opt(key::memory,               &traceframe_collection::memory,               list_of(nested<memory_region>())));
 }
 
-template <> source_info parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<trace_variable>)
 {
-    source_info sl;
+    return std::make_tuple(
+            req(key::name,    &trace_variable::name,    str),
+            req(key::initial, &trace_variable::initial, dec),
+            opt(key::current, &trace_variable::current, dec));
+}
 
-    sl.file     = find(r, "file").as_string();
-    if (auto val = find_if(r, "line")) sl.line     = std::stoi(val->as_string());
-    if (auto val = find_if(r, "line")) sl.fullname = val->as_string();
-    if (auto val = find_if(r, "macro-info")) sl.macro_info = val->as_string();
-    return sl;
+constexpr auto reflect(tag<trace_status>)
+{
+    return std::make_tuple(
+            req(key::supported,           &trace_status::supported,           one),
+            opt(key::running,             &trace_status::running,             one),
+            opt(key::stop_reason,         &trace_status::stop_reason,         str),
+            opt(key::stopping_tracepoint, &trace_status::stopping_tracepoint, dec),
+            opt(key::frames,              &trace_status::frames,              dec),
+            opt(key::frames_created,      &trace_status::frames_created,      dec),
+            opt(key::buffer_size,         &trace_status::buffer_size,         dec),
+            opt(key::buffer_free,         &trace_status::buffer_free,         dec),
+            opt(key::circular,            &trace_status::circular,            one),
+            opt(key::disconnected,        &trace_status::disconnected,        one),
+            opt(key::trace_file,          &trace_status::trace_file,          str));
 }
 
-template<> download_info parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<symbol_line>)
 {
-    download_info di;
+    return std::make_tuple(
+            req(key::pc,   &symbol_line::pc,   hex),
+            req(key::line, &symbol_line::line, str));
+}
 
-    di.address       = my_stoull(find(r, "address").as_string(), nullptr, 16);
-    di.load_size     = my_stoull(find(r, "load-size").as_string());
-    di.transfer_rate = my_stoull(find(r, "transfer-rate").as_string());
-    di.write_rate    = my_stoull(find(r, "write-rate").as_string());
+constexpr auto reflect(tag<source_info>)
+{
+    return std::make_tuple(
+            req(key::file,       &source_info::file,       str),
+            opt(key::line,       &source_info::line,       dec),
+            opt(key::fullname,   &source_info::fullname,   str),
+            opt(key::macro_info, &source_info::macro_info, str));
+}
 
-    return di;
+constexpr auto reflect(tag<download_info>)
+{
+    return std::make_tuple(
+            req(key::address,       &download_info::address,       hex),
+            req(key::load_size,     &download_info::load_size,     dec),
+            req(key::transfer_rate, &download_info::transfer_rate, dec),
+            req(key::write_rate,    &download_info::write_rate,    dec));
 }
 
-template<> download_status parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<download_status>)
 {
-    download_status ds;
+    return std::make_tuple(
+            req(key::section,      &download_status::section,      str),
+            opt(key::section_sent, &download_status::section_sent, dec),
+            opt(key::total_sent,   &download_status::total_sent,   dec),
+            req(key::section_size, &download_status::section_size, dec),
+            req(key::total_size,   &download_status::total_size,   dec));
+}
 
-    ds.section = find(r, "section").as_string();
-    if (auto val = find_if(r, "section-sent")) ds.section_sent = my_stoull(find(r, "sections-sent").as_string());
-    if (auto val = find_if(r, "total-sent"))   ds.total_sent   = my_stoull(find(r, "total-sent").as_string());
-    ds.section_size  = my_stoull(find(r, "sections-size").as_string());
-    ds.total_size    = my_stoull(find(r, "total-size").as_string());
+constexpr auto reflect(tag<connection_notification>)
+{
+    return std::make_tuple(
+            opt(key::addr, &connection_notification::addr, str),
+            opt(key::func, &connection_notification::func, str),
+            opt(key::args, &connection_notification::args, list_of(str)));
+}
 
-    return ds;
+constexpr auto reflect(tag<info_ada_exception>)
+{
+    return std::make_tuple(
+            req(key::name,    &info_ada_exception::name,    str),
+            req(key::address, &info_ada_exception::address, hex));
 }
 
-template<> connection_notification parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<thread_group_added>)
 {
-    connection_notification cn;
+    return std::make_tuple(req(key::id, &thread_group_added::id, group_id));
+}
 
-    if (auto val = find_if(r, "addr")) cn.addr = my_stoull(val->as_string(), nullptr, 16);
-    if (auto val = find_if(r, "func")) cn.func = val->as_string();
+constexpr auto reflect(tag<thread_group_removed>)
+{
+    return std::make_tuple(req(key::id, &thread_group_removed::id, group_id));
+}
 
-    if (auto val = find_if(r, "args"))
-    {
-        auto v = val->as_list().as_values();
+constexpr auto reflect(tag<thread_group_started>)
+{
+    return std::make_tuple(
+            req(key::id,  &thread_group_started::id,  group_id),
+            req(key::pid, &thread_group_started::pid, dec));
+}
 
-        cn.args.reserve(v.size());
-        for (auto & x : v)
-            cn.args.push_back(x.as_string());
-    }
-    return cn;
+constexpr auto reflect(tag<thread_group_exited>)
+{
+    return std::make_tuple(
+            req(key::id,        &thread_group_exited::id,     group_id),
+            opt(key::exit_code, &thread_group_exited::exited, oct));
 }
 
-template<> info_ada_exception parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<thread_created>)
 {
-    info_ada_exception ai;
+    return std::make_tuple(
+            req(key::id,       &thread_created::id,  dec),
+            opt(key::group_id, &thread_created::gid, group_id));
+}
 
-    ai.name          = find(r, "name").as_string();
-    ai.address       = my_stoull(find(r, "address").as_string(), nullptr, 16);
+constexpr auto reflect(tag<thread_exited>)
+{
+    return std::make_tuple(
+            req(key::id,       &thread_exited::id,  dec),
+            opt(key::group_id, &thread_exited::gid, group_id));
+}
 
-    return ai;
+constexpr auto reflect(tag<thread_selected>)
+{
+    return std::make_tuple(
+            req(key::id,       &thread_selected::id,  dec),
+            opt(key::group_id, &thread_selected::gid, group_id));
 }
 
-template<> thread_group_added parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<library_loaded>)
 {
-    thread_group_added tga;
+    return std::make_tuple(
+            req(key::id,             &library_loaded::id,             dec),
+            req(key::target_name,    &library_loaded::target_name,    str),
+            req(key::host_name,      &library_loaded::host_name,      str),
+            opt(key::symbols_loaded, &library_loaded::symbols_loaded, str));
+}
 
-    tga.id = std::stoi(find(r, "id").as_string());
+constexpr auto reflect(tag<traceframe_changed_t>)
+{
+    return std::make_tuple(
+            req(key::num,        &traceframe_changed_t::num,        dec),
+            req(key::tracepoint, &traceframe_changed_t::tracepoint, str));
+}
 
-    return tga;
+constexpr auto reflect(tag<tsv_frame>)
+{
+    return std::make_tuple(
+            opt(key::name,    &tsv_frame::name,    str),
+            opt(key::initial, &tsv_frame::initial, str));
 }
 
-template<> thread_group_removed parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<tsv_modified>)
 {
-    thread_group_removed tgr;
-    tgr.id = std::stoi(find(r, "id").as_string());
-    return tgr;
+    return std::make_tuple(
+            req(key::name,    &tsv_modified::name,    str),
+            req(key::initial, &tsv_modified::initial, str),
+            opt(key::current, &tsv_modified::current, str));
 }
 
-template<> thread_group_started parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<breakpoint_created>)
 {
-    thread_group_started tgr;
-    tgr.id  = std::stoi(find(r,  "id").as_string());
-    tgr.pid = std::stoi(find(r, "pid").as_string());
-    return tgr;
+    return std::make_tuple(req(key::bkpt, &breakpoint_created::bkpt, nested<breakpoint>()));
 }
 
-template<> thread_group_exited parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<breakpoint_modified>)
 {
-    thread_group_exited tgr;
-    tgr.id  = std::stoi(find(r,  "id").as_string());
-    if (auto val = find_if(r, "exited")) tgr.exited = std::stoi(val->as_string());
-    return tgr;
+    return std::make_tuple(req(key::bkpt, &breakpoint_modified::bkpt, nested<breakpoint>()));
 }
 
-template<> thread_created parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<breakpoint_deleted>)
 {
-    thread_created tgr;
-    tgr.id  = std::stoi(find(r,  "id").as_string());
-    tgr.gid = std::stoi(find(r, "gid").as_string());
-    return tgr;
+    return std::make_tuple(req(key::number, &breakpoint_deleted::number, dec));
 }
 
-template<> thread_exited parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<record_started>)
 {
-    thread_exited tgr;
-    tgr.id  = std::stoi(find(r,  "id").as_string());
-    tgr.gid = std::stoi(find(r, "gid").as_string());
-    return tgr;
+    return std::make_tuple(
+            req(key::thread_group, &record_started::thread_group, group_id),
+            req(key::method,       &record_started::method,       str),
+            opt(key::format,       &record_started::format,       str));
 }
 
-template<> thread_selected parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<record_stopped>)
 {
-    thread_selected tgr;
-    tgr.id  = std::stoi(find(r,  "id").as_string());
-    tgr.gid = std::stoi(find(r, "gid").as_string());
-    return tgr;
+    return std::make_tuple(req(key::thread_group, &record_stopped::thread_group, group_id));
 }
 
-template<> library_loaded parse_result(const std::vector<result> & r)
+constexpr auto reflect(tag<cmd_param_changed>)
 {
-    library_loaded tgr;
-    tgr.id          = std::stoi(find(r,  "id").as_string());
-    tgr.host_name   = find(r, "host-name").as_string();
-    tgr.target_name = find(r, "target-name").as_string();
+    return std::make_tuple(
+            req(key::param, &cmd_param_changed::param, str),
+            req(key::value, &cmd_param_changed::value, str));
+}
 
-    if (auto val = find_if(r, "symbols-loaded")) tgr.symbols_loaded = val->as_string();
-    return tgr;
+constexpr auto reflect(tag<memory_changed>)
+{
+    return std::make_tuple(
+            req(key::thread_group, &memory_changed::thread_group, group_id),
+            req(key::addr,         &memory_changed::addr,         hex),
+            req(key::len,          &memory_changed::len,          dec),
+            opt(key::code,         &memory_changed::code,         str));
 }
 
-template<> traceframe_changed parse_result(const std::vector<result> & r)
+namespace
 {
-    if (find_if(r, "end"))
-        return traceframe_changed_end();
 
-    traceframe_changed_t tct;
-    tct.num         =  std::stoi(find(r,  "num").as_string());
-    tct.tracepoint  = find(r, "tracepoint").as_string();
-    return tct;
-}
+//maps a key to the index of its field + 1, 0 if the key is not a field.
+struct field_index
+{
+    std::uint8_t slots[key_count];
+};
 
-template<> tsv_frame parse_result(const std::vector<result> & r)
+template<typename Fields, std::size_t ... I>
+constexpr field_index make_field_index(const Fields & fields, std::index_sequence<I...>)
 {
-    tsv_frame tf;
-    if (auto val = find_if(r, "name")) tf.name = val->as_string();
-    if (auto val = find_if(r, "initial")) tf.initial = val->as_string();
-    return tf;
+    field_index idx{};
+    const key keys[] = {key::unknown, std::get<I>(fields).key_...};
+    for (std::size_t i = 1u; i <= sizeof...(I); i++)
+        idx.slots[static_cast<std::size_t>(keys[i])] = static_cast<std::uint8_t>(i);
+    return idx;
 }
 
-template<> tsv_modified parse_result(const std::vector<result> & r)
+template<typename Fields, std::size_t ... I>
+constexpr std::uint64_t make_required_mask(const Fields & fields, std::index_sequence<I...>)
 {
-    tsv_modified tf;
-    tf.name = find(r, "name").as_string();
-    tf.initial = find(r, "initial").as_string();
-    if (auto val = find_if(r, "current")) tf.current = val->as_string();
-    return tf;
+    const bool required[] = {false, std::get<I>(fields).required...};
+    std::uint64_t mask = 0u;
+    for (std::size_t i = 1u; i <= sizeof...(I); i++)
+        if (required[i])
+            mask |= std::uint64_t(1u) << (i - 1u);
+    return mask;
 }
 
-template<> breakpoint_created parse_result(const std::vector<result> & r)
+//decodes a tuple in a single pass, dispatching on the interned key of each result.
+template<typename T>
+struct decoder
 {
-    breakpoint_created bc;
-    bc.bkpt = parse_result<breakpoint>(find(r, "bkpt").as_tuple());
-    return bc;
+    using fields_t  = decltype(reflect(tag<T>{}));
+    using indices   = std::make_index_sequence<std::tuple_size<fields_t>::value>;
+    using handler_t = void(*)(T&, const value&);
+
+    static_assert(std::tuple_size<fields_t>::value <= 64u, "too many fields");
+
+    constexpr static fields_t      fields   = reflect(tag<T>{});
+    constexpr static field_index   index    = make_field_index(fields, indices{});
+    constexpr static std::uint64_t required = make_required_mask(fields, indices{});
+
+    template<std::size_t I>
+    static void apply(T & t, const value & v)
+    {
+        const auto & f = std::get<I>(fields);
+        assign(f.conv, v, t.*f.member, 0);
+    }
+
+    template<std::size_t ... I>
+    static const handler_t * handlers(std::index_sequence<I...>)
+    {
+        static const handler_t h[] = {&apply<I>...};
+        return h;
+    }
+
+    template<std::size_t ... I>
+    static const key * keys(std::index_sequence<I...>)
+    {
+        static const key k[] = {std::get<I>(fields).key_...};
+        return k;
+    }
+
+    static T decode(const result_list & r)
+    {
+        T t{};
+        auto h = handlers(indices{});
+        std::uint64_t found = 0u;
+
+        for (auto & res : r)
+        {
+            auto slot = index.slots[static_cast<std::size_t>(res.key_)];
+            if (slot == 0u)
+                continue;
+
+            auto bit = std::uint64_t(1u) << (slot - 1u);
+            if (found & bit) //the first one counts, like with find.
+                continue;
+
+            h[slot - 1u](t, res.value_);
+            found |= bit;
+        }
+
+        if ((found & required) != required)
+        {
+            auto ks = keys(indices{});
+            for (std::size_t i = 0u; i < std::tuple_size<fields_t>::value; i++)
+                if ((required & ~found) & (std::uint64_t(1u) << i))
+                    BOOST_THROW_EXCEPTION( missing_value(key_name(ks[i]).to_string()) );
+        }
+        return t;
+    }
+};
+
+template<typename T> constexpr typename decoder<T>::fields_t decoder<T>::fields;
+template<typename T> constexpr field_index   decoder<T>::index;
+template<typename T> constexpr std::uint64_t decoder<T>::required;
+
 }
 
-template<> breakpoint_modified parse_result(const std::vector<result> & r)
+template<typename T>
+T parse_result(const result_list & r)
 {
-    breakpoint_modified bc;
-    bc.bkpt = parse_result<breakpoint>(find(r, "bkpt").as_tuple());
-    return bc;
+    return decoder<T>::decode(r);
 }
 
-template<> breakpoint_deleted parse_result(const std::vector<result> & r)
+namespace
 {
-    breakpoint_deleted bc;
-    bc.number = std::stoi(find(r, "number").as_string());
-    return bc;
-}
 
-template<> record_started    parse_result(const std::vector<result> & r)
+void decode_hit_args(const value & v, breakpoint_hit & hit)
 {
-    record_started bc;
-    bc.thread_group = std::stoi(find(r, "thread-group").as_string());
-    if (auto val = find_if(r, "format")) bc.format = val->as_string();
-    bc.method = find(r, "method").as_string();
-    return bc;
+    auto & l = v.as_list();
+    hit.has_args = true;
+    if (l.type() != boost::typeindex::type_id<value_list>()) //only names given
+    {
+        auto & names = l.as_results();
+        hit.args.resize(names.size());
+        for (std::size_t i = 0u; i < names.size(); i++)
+        {
+            hit.args[i].name = names[i].value_.as_string();
+            hit.args[i].value.clear();
+            hit.args[i].type = boost::none;
+        }
+        return;
+    }
+
+    auto & vals = l.as_values();
+    hit.args.resize(vals.size());
+    for (std::size_t i = 0u; i < vals.size(); i++)
+    {
+        auto & a = hit.args[i];
+        a.name.clear();
+        a.value.clear();
+        a.type = boost::none;
+        for (auto & res : vals[i].as_tuple())
+            switch (res.key_)
+            {
+            case key::name:  a.name  = res.value_.as_string(); break;
+            case key::value: a.value = res.value_.as_string(); break;
+            case key::type:  a.type  = res.value_.as_string(); break;
+            default: break;
+            }
+    }
 }
 
-template<> record_stopped    parse_result(const std::vector<result> & r)
+}
+
+bool parse_breakpoint_hit(const result_list & results, breakpoint_hit & hit)
 {
-    record_stopped rs;
-    rs.thread_group = std::stoi(find(r, "thread-group").as_string());
-    return rs;
+    hit.bkptno = hit.thread_id = hit.core = hit.line = -1;
+    hit.addr = boost::none;
+    hit.func.clear();
+    hit.file.clear();
+    hit.fullname.clear();
+    hit.has_args = false;
+
+    for (auto & res : results)
+    {
+        switch (res.key_)
+        {
+        case key::bkptno:    hit.bkptno    = static_cast<int>(my_stoll(res.value_.as_string())); break;
+        case key::thread_id: hit.thread_id = static_cast<int>(my_stoll(res.value_.as_string())); break;
+        case key::core:      hit.core      = static_cast<int>(my_stoll(res.value_.as_string())); break;
+        case key::frame:
+            for (auto & fr : res.value_.as_tuple())
+                switch (fr.key_)
+                {
+                case key::addr:     hit.addr     = my_stoull(fr.value_.as_string(), nullptr, 16); break;
+                case key::func:     hit.func     = fr.value_.as_string(); break;
+                case key::file:     hit.file     = fr.value_.as_string(); break;
+                case key::fullname: hit.fullname = fr.value_.as_string(); break;
+                case key::line:     hit.line     = static_cast<int>(my_stoll(fr.value_.as_string())); break;
+                case key::args:     decode_hit_args(fr.value_, hit); break;
+                default: break;
+                }
+            break;
+        default:
+            break;
+        }
+    }
+    if (!hit.has_args)
+        hit.args.clear();
+    return hit.bkptno != -1;
 }
 
-template<> cmd_param_changed parse_result(const std::vector<result> & r)
+std::vector<breakpoint> parse_breakpoints(const result_list & results)
 {
-    cmd_param_changed rs;
-    rs.param = find(r, "param").as_string();
-    rs.value = find(r, "value").as_string();
-    return rs;
+    std::vector<breakpoint> bps;
+
+    for (auto & res : results)
+    {
+        if (res.key_ != key::bkpt)
+            continue;
+
+        if (bps.empty())
+            bps.push_back(decoder<breakpoint>::decode(res.value_.as_tuple()));
+        else
+        {
+            breakpoint loc = decoder<breakpoint_location>::decode(res.value_.as_tuple());
+            loc.type = bps.front().type;
+            loc.disp = bps.front().disp;
+            bps.push_back(std::move(loc));
+        }
+    }
+
+    return bps;
 }
 
-template<> memory_changed    parse_result(const std::vector<result> & r)
+template<> boost::optional<found_tracepoint> parse_result(const result_list & r)
 {
-    memory_changed mc;
-    mc.thread_group = std::stoi(find(r, "thread-group").as_string());
-    mc.len = std::stoi(find(r, "len").as_string());
-    mc.addr = my_stoull(find(r, "addr"). as_string(), nullptr, 16);
-    if (auto val = find_if(r, "code")) mc.code = val->as_string();
-    return mc;
+    if (!find_if(r, key::found))
+        return boost::none;
+
+    return decoder<found_tracepoint>::decode(r);
 }
 
+template<> traceframe_changed parse_result(const result_list & r)
+{
+    if (find_if(r, key::end))
+        return traceframe_changed_end();
+
+    return decoder<traceframe_changed_t>::decode(r);
+}
 
+template error_                  parse_result<error_>                 (const result_list &);
+template breakpoint              parse_result<breakpoint>             (const result_list &);
+template watchpoint              parse_result<watchpoint>             (const result_list &);
+template arg                     parse_result<arg>                    (const result_list &);
+template frame                   parse_result<frame>                  (const result_list &);
+template thread                  parse_result<thread>                 (const result_list &);
+template groups                  parse_result<groups>                 (const result_list &);
+template thread_info             parse_result<thread_info>            (const result_list &);
+template thread_state            parse_result<thread_state>           (const result_list &);
+template thread_id_list          parse_result<thread_id_list>         (const result_list &);
+template thread_select           parse_result<thread_select>          (const result_list &);
+template ada_task_info           parse_result<ada_task_info>          (const result_list &);
+template varobj                  parse_result<varobj>                 (const result_list &);
+template varobj_update           parse_result<varobj_update>          (const result_list &);
+template line_asm_insn           parse_result<line_asm_insn>          (const result_list &);
+template src_and_asm_line        parse_result<src_and_asm_line>       (const result_list &);
+template register_value          parse_result<register_value>         (const result_list &);
+template memory_entry            parse_result<memory_entry>           (const result_list &);
+template read_memory             parse_result<read_memory>            (const result_list &);
+template read_memory_bytes       parse_result<read_memory_bytes>      (const result_list &);
+template memory_region           parse_result<memory_region>          (const result_list &);
+template traceframe_collection   parse_result<traceframe_collection>  (const result_list &);
+template trace_variable          parse_result<trace_variable>         (const result_list &);
+template trace_status            parse_result<trace_status>           (const result_list &);
+template symbol_line             parse_result<symbol_line>            (const result_list &);
+template source_info             parse_result<source_info>            (const result_list &);
+template download_info           parse_result<download_info>          (const result_list &);
+template download_status         parse_result<download_status>        (const result_list &);
+template connection_notification parse_result<connection_notification>(const result_list &);
+template info_ada_exception      parse_result<info_ada_exception>     (const result_list &);
+template thread_group_added      parse_result<thread_group_added>     (const result_list &);
+template thread_group_removed    parse_result<thread_group_removed>   (const result_list &);
+template thread_group_started    parse_result<thread_group_started>   (const result_list &);
+template thread_group_exited     parse_result<thread_group_exited>    (const result_list &);
+template thread_created          parse_result<thread_created>         (const result_list &);
+template thread_exited           parse_result<thread_exited>          (const result_list &);
+template thread_selected         parse_result<thread_selected>        (const result_list &);
+template library_loaded          parse_result<library_loaded>         (const result_list &);
+template tsv_frame               parse_result<tsv_frame>              (const result_list &);
+template tsv_modified            parse_result<tsv_modified>           (const result_list &);
+template breakpoint_created      parse_result<breakpoint_created>     (const result_list &);
+template breakpoint_modified     parse_result<breakpoint_modified>    (const result_list &);
+template breakpoint_deleted      parse_result<breakpoint_deleted>     (const result_list &);
+template record_started          parse_result<record_started>         (const result_list &);
+template record_stopped          parse_result<record_stopped>         (const result_list &);
+template cmd_param_changed       parse_result<cmd_param_changed>      (const result_list &);
+template memory_changed          parse_result<memory_changed>         (const result_list &);
 
 }
 }
@@ -17,6 +17,7 @@
 #define BOOST_COROUTINE_NO_DEPRECATION_WARNING
 #include <mw/gdb/process.hpp>
 #include <mw/gdb/mi2/frame_impl.hpp>
+#include <mw/gdb/mi2/cstring.hpp>
 
 #include <boost/variant/get.hpp>
 #include <iostream>
@@ -68,11 +69,56 @@ void process::_run_impl(boost::asio::yield_context &yield_)
         interpreter.target_select_remote(_remote);
 
     _init_bps(interpreter);
+
+    //a local inferior is started by exec_run, so the pid reported by gdb belongs to a process on this machine.
+    boost::signals2::scoped_connection started, exited;
+    if (_direct_memory && _remote.empty() && _init_scripts.empty())
+    {
+        //memory written through /proc bypasses gdb, so it must not cache any.
+        interpreter.gdb_set("stack-cache", "off");
+        interpreter.gdb_set("code-cache",  "off");
+
+        started = interpreter.async_record_handler.connect_thread_group_started(
+                [this](const mi2::thread_group_started & tg)
+                {
+                    _pid = tg.pid;
+                    if (!_proc_memory.open(tg.pid))
+                        _log << "Direct memory access to process " << tg.pid << " not available" << std::endl;
+                });
+        exited = interpreter.async_record_handler.connect_thread_group_exited(
+                [this](const mi2::thread_group_exited &)
+                {
+                    _proc_memory.close();
+                });
+    }
+
+    //writes done by gdb itself, e.g. by an init script, are reported for the watched regions even if the value is the same.
+    boost::signals2::scoped_connection mem_changed = interpreter.async_record_handler.connect_memory_changed(
+            [this](const mi2::memory_changed & mc)
+            {
+                _watched_memory.mark(mc.addr, static_cast<std::uint64_t>(mc.len));
+            });
+
+    boost::signals2::scoped_connection trace;
+    if (!_trace_points.empty())
+        trace = interpreter.stream_console_sig().connect([this](const std::string & st){_trace_output(st);});
+
+    std::string cache_key;
+    if (!_arg_cache_file.empty())
+    {
+        cache_key = arg_cache::key(_arg_cache_exe);
+        if (_arg_cache.load(_arg_cache_file, cache_key))
+            _log << "Argument cache loaded from " << _arg_cache_file.string() << std::endl;
+    }
+
     _start(interpreter);
 
 
     _handle_bps(interpreter);
 
+    if (!_arg_cache_file.empty() && _arg_cache.modified() && !_arg_cache.save(_arg_cache_file, cache_key))
+        _log << "Argument cache could not be written to " << _arg_cache_file.string() << std::endl;
+
     reset_timer();
 
     interpreter.gdb_exit();
@@ -108,45 +154,110 @@ void process::_read_info(mi2::interpreter & interpreter)
 
 void process::_init_bps(mi2::interpreter & interpreter)
 {
-    for (auto & bp : _break_points)
+    //all breakpoints are sent at once, the replies are matched by their token.
+    for (auto & bp_ptr : _break_points)
     {
-        _log << "\nSetting Breakpoint " << bp->identifier() << endl;
-
-        try
+        auto bp = bp_ptr.get();
+        auto on_insert =
+                [this, bp](std::vector<mi2::breakpoint> && bpv, const std::string & error)
+                {
+                    _log << "\nSetting Breakpoint " << bp->identifier() << '\n';
+                    if (bpv.empty())
+                    {
+                        _log << "Breakpoint not found: " << error << "\n\n";
+                        bp->set_not_found();
+                        return;
+                    }
+
+                    //a failing breakpoint must not keep the others from being set.
+                    try
+                    {
+                        auto & b = bpv[0];
+                        _add_break_point(b.number, bp);
+                        for (auto & loc : bpv)
+                            if (loc.addr != 0u) //"<MULTIPLE>" or "<PENDING>"
+                                _break_point_addresses.insert(
+                                        std::upper_bound(_break_point_addresses.begin(), _break_point_addresses.end(), loc.addr),
+                                        loc.addr);
+
+                        if (bpv.size() == 1)
+                        {
+                            std::string file = b.filename ? *b.filename : std::string();
+                            auto line = b.line ? *b.line : -1;
+                            bp->set_at(b.addr, file, line);
+                            _log << "Set here: " << file << ":" << line << "\n\n";
+
+                        }
+                        else
+                        {
+                            std::string func = b.original_location ? *b.original_location : std::string();
+                            bp->set_multiple(b.addr, func, bpv.size() -1);
+                            _log << "Set multiple breakpoints: " << func << ":" << (bpv.size() -1) << "\n\n";
+
+                        }
+                    }
+                    catch (std::exception & e)
+                    {
+                        _log << "Breakpoint not set: " << e.what() << "\n\n";
+                        bp->set_not_found();
+                    }
+                };
+
+        //a trace point prints its output with a tag, so it can be found in the console output while the target runs.
+        if (auto tp = dynamic_cast<mw::debug::trace_point*>(bp))
         {
-            auto bpv = interpreter.break_insert(bp->identifier(),
-                    false, false, false, false, false,
-                    bp->condition());
-
-            auto & b = bpv[0];
-            _break_point_map[b.number] = bp.get();
+            auto format = mi2::escape_cstring(_trace_filter.tag() + std::to_string(_trace_points.size()) + ":" + tp->format() + "\n");
+            //every argument is quoted, so an expression with spaces or quotes stays one argument.
+            std::vector<std::string> arguments;
+            for (auto & arg : tp->arguments())
+                arguments.push_back(mi2::escape_cstring(arg));
+            _trace_points.push_back(tp);
+            interpreter.pipeline_dprintf_insert(bp->identifier(), format, arguments, on_insert, bp->condition());
+        }
+        else
+            interpreter.pipeline_break_insert(bp->identifier(), on_insert, bp->condition());
+    }
 
-            BOOST_ASSERT(bpv.size() > 0);
-            if (bpv.size() == 1)
-            {
-                std::string file = b.filename ? *b.filename : std::string();
-                auto line = b.line ? *b.line : -1;
-                bp->set_at(b.addr, file, line);
-                _log << "Set here: " << file << ":" << line << endl << endl;
+    try
+    {
+        interpreter.flush();
+    }
+    catch (...)
+    {
+        _log << "Parse error during breakpoint declaration" << endl;
+        throw;
+    }
+    _log << flush;
+    reset_timer();
+}
 
-            }
-            else
+void process::_trace_output(const std::string & st)
+{
+    _trace_filter.feed(st, _trace_points.size(),
+            [this](std::size_t idx, const std::string & text)
             {
-                std::string func = b.original_location ? *b.original_location : std::string();
-                bp->set_multiple(b.addr, func, bpv.size() -1);
-                _log << "Set multiple breakpoints: " << func << ":" << (bpv.size() -1) << endl << endl;
+                try
+                {
+                    _trace_points[idx]->trace(text);
+                }
+                catch (std::exception & e)
+                {
+                    _log << "Exception in trace point " << _trace_points[idx]->identifier() << ": " << e.what() << std::endl;
+                }
+            });
+}
 
-            }
-        }
-        catch (mi2::unexpected_result_class & ie) //just ignore it on error
-        {
-            if (ie.got != mi2::result_class::error)
-            {
-                _log << "Parse error during breakpoint declaration of " << bp->identifier() << endl;
-                throw;
-            }
-        }
-    }
+void process::_add_break_point(int number, break_point * bp)
+{
+    if (number < 0)
+        return;
+    if (static_cast<std::size_t>(number) >= _break_point_table.size())
+        _break_point_table.resize(number + 1, nullptr);
+    _break_point_table[number] = bp;
+
+    auto & numbers = _break_point_numbers[bp];
+    if (std::find(numbers.begin(), numbers.end(), number) == numbers.end())
+        numbers.push_back(number);
 }
 
 void process::_start(mi2::interpreter & interpreter)
@@ -162,33 +273,46 @@ void process::_start(mi2::interpreter & interpreter)
 
 void process::_handle_bps  (mi2::interpreter & interpreter)
 {
-    auto val = interpreter.wait_for_stop();
+    mi2::breakpoint_hit hit;
+    auto val = interpreter.wait_for_stop(hit);
 
-    std::unordered_map<std::uint64_t, std::vector<std::string>> arg_name_map;
 
     while(val.reason != "exited")
     {
         reset_timer();
         if (val.reason != "breakpoint-hit") //temporary
         {
+            if ((val.reason == "signal-received") && _dump_at_signal)
+            {
+                mi2::frame_impl fi{"", {}, *this, interpreter, _log};
+                _dump(fi, "signal");
+            }
             _log << "unknown stop reason" << std::endl;
             break;
         }
 
-        int num = std::stoi(mi2::find(val.content, "bkptno").as_string());
-       // int thread_id = std::stoi(mi2::find(val.second, "thread-id").as_string());
-        auto frame = mi2::parse_result<mi2::frame>(mi2::find(val.content, "frame").as_tuple());
+        if (hit.bkptno == -1)
+            BOOST_THROW_EXCEPTION( mi2::missing_value("bkptno") );
+
+        auto bp = break_point_at(hit.bkptno);
+        if (bp == nullptr) //e.g. set by an init script
+        {
+            _log << "Unknown breakpoint " << hit.bkptno << " hit" << std::endl;
+            interpreter.exec_continue();
+            val = interpreter.wait_for_stop(hit);
+            continue;
+        }
 
-        std::string id;
-        if (frame.func)
-            id = *frame.func;
+        std::string id = hit.func;
 
         std::vector<mw::debug::arg> args;
-        if (frame.args)
+        std::vector<boost::optional<std::string>> raw_args;
+        if (hit.has_args)
         {
             std::vector<std::string> arg_names;
 
-            if (!frame.addr || (arg_name_map.count(*frame.addr) == 0))
+            auto cached = hit.addr ? _arg_cache.find(*hit.addr) : nullptr;
+            if (cached == nullptr)
             {
                 //alright, the gdb can add more arguments as @entry, so we ought to read the proper argument list first.
                 auto arg_names_frames = interpreter.stack_list_arguments(mi2::print_values::no_values, std::pair<std::size_t, std::size_t>{0,0});
@@ -200,56 +324,51 @@ void process::_handle_bps  (mi2::interpreter & interpreter)
                     for (auto & a : *args)
                         arg_names.push_back(a.name);
                 }
-                if (frame.addr)
-                    arg_name_map[*frame.addr] = arg_names;
+                if (hit.addr)
+                    _arg_cache.add(*hit.addr, arg_names);
             }
             else
-                arg_names = arg_name_map[*frame.addr];
+                arg_names = *cached;
 
             args.reserve(arg_names.size());
+            raw_args.reserve(arg_names.size());
 
-            auto & args_in = *frame.args;
+            auto & args_in = hit.args;
 
+            //the values are only decoded when the breakpoint accesses them, a reference would need another round trip.
             for (auto & a : arg_names)
             {
                 auto itr = std::find_if(args_in.begin(), args_in.end(), [&a](auto & val){return val.name == a;});
 
                 mw::debug::arg as;
+                boost::optional<std::string> raw;
 
                 if (itr != args_in.end())
                 {
-                    auto arg = mi2::parse_var(interpreter, itr->name, itr->value);
-                    this->reset_timer();
-
-                    as.ref     = arg.ref;
-                    as.value   = arg.value;
-                    as.cstring = arg.cstring;
-                    as.id      = itr->name;
+                    as.id = itr->name;
+                    raw   = std::move(itr->value);
                 }
                 args.push_back(std::move(as));
-
+                raw_args.push_back(std::move(raw));
             }
 
 
 
         }
-        mi2::frame_impl fi{std::move(id), std::move(args), *this, interpreter, _log};
-
-        std::string file;
-        int line = -1;
+        mi2::frame_impl fi{std::move(id), std::move(args), *this, interpreter, _log, std::move(raw_args)};
 
-        if (frame.file)
-            file = *frame.file;
-        if (frame.line)
-            line = *frame.line;
-
-        _break_point_map[num]->invoke(fi, file, line);
+        bp->invoke(fi, hit.file, hit.line);
+        fi.flush();
 
         if (_exited) //manual exit, as set by _exit breakpoint
+        {
+            if (_dump_at_exit)
+                _dump(fi, "exit");
             return;
+        }
         interpreter.exec_continue();
 
-        val = interpreter.wait_for_stop();
+        val = interpreter.wait_for_stop(hit);
     }
 
     if (val.reason == "exited-normally")
@@ -257,13 +376,61 @@ void process::_handle_bps  (mi2::interpreter & interpreter)
 
     if (val.reason == "exited")
     {
-        int exit_code = std::stoi(find(val.content, "exit-code").as_string(), nullptr, 8);
+        int exit_code = std::stoi(find(val.content, mi2::key::exit_code).as_string(), nullptr, 8);
         this->set_exit(exit_code);
     }
 
 }
 
 
+void process::_dump(mi2::frame_impl & fi, const char * trigger)
+{
+    for (auto & dr : _dump_regions)
+    {
+        //a region that can't be dumped, e.g. because of a bad path, must not keep the exit code from being reported.
+        try
+        {
+            auto done = fi.dump_memory(dr.addr, dr.size, dr.file, _dump_sparse);
+            _log << "Dumped memory [" << trigger << "] 0x" << std::hex << dr.addr << std::dec << ":" << done
+                 << " of " << dr.size << " bytes to " << dr.file << std::endl;
+        }
+        catch (std::exception & e)
+        {
+            _log << "Dumping memory [" << trigger << "] 0x" << std::hex << dr.addr << std::dec
+                 << " to " << dr.file << " failed: " << e.what() << std::endl;
+        }
+    }
+}
+
+const memory_map & process::target_memory_map(mi2::interpreter & interpreter)
+{
+    if (_memory_map_loaded || !_use_memory_map)
+        return _memory_map;
+    _memory_map_loaded = true;
+
+    std::string text;
+    boost::signals2::scoped_connection conn = interpreter.stream_console_sig().connect(
+            [&](const std::string & st)
+            {
+                text += st;
+            });
+    try
+    {
+        interpreter.interpreter_exec("console", "info mem");
+    }
+    catch (mi2::interpreter_error & ie)
+    {
+        _log << "Memory map not available: " << ie.what() << std::endl;
+        return _memory_map;
+    }
+    reset_timer();
+
+    _memory_map = memory_map::from_info_mem(text);
+    if (!_memory_map.empty())
+        _log << "Memory map with " << _memory_map.regions().size() << " regions loaded" << std::endl;
+    return _memory_map;
+}
+
 void process::reset_timer()
 {
     if (_time_out > 0)
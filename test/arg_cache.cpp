@@ -0,0 +1,202 @@
+/**
+ * @file   /gdb-runner/test/arg_cache.cpp
+ * @date   16.10.2026
+ * @author Klemens D. Morgenstern
+ *
+ * Published under [Apache License 2.0](http://www.apache.org/licenses/LICENSE-2.0.html)
+  <pre>
+    /  /|  (  )   |  |  /
+   /| / |   \/    | /| /
+  / |/  |   /\    |/ |/
+ /  /   |  (  \   /  |
+               ) 
+</pre>
+ */
+
+#include <mw/gdb/arg_cache.hpp>
+
+#define BOOST_TEST_MODULE arg_cache_test
+#define BOOST_TEST_NO_LIB
+
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gdb = mw::gdb;
+namespace fs  = boost::filesystem;
+
+//a temporary directory for the files of one test case.
+struct temp_dir
+{
+    fs::path path = fs::temp_directory_path() / fs::unique_path("mw-arg-cache-%%%%-%%%%");
+    temp_dir()  {fs::create_directory(path);}
+    ~temp_dir() {boost::system::error_code ec; fs::remove_all(path, ec);}
+};
+
+//a minimal elf file with a null section, a progbits section and a note section, which holds an ABI tag and the build-id.
+static std::vector<std::uint8_t> make_elf(bool is64, bool big_endian, bool with_build_id = true)
+{
+    std::vector<std::uint8_t> f(0x300u, 0u);
+    auto put = [&](std::size_t pos, std::uint64_t value, std::size_t size)
+               {
+                   for (std::size_t i = 0u; i < size; i++)
+                       f[pos + (big_endian ? size - 1 - i : i)] = static_cast<std::uint8_t>(value >> (8 * i));
+               };
+
+    f[0] = 0x7f; f[1] = 'E'; f[2] = 'L'; f[3] = 'F';
+    f[4] = is64 ? 2 : 1;
+    f[5] = big_endian ? 2 : 1;
+
+    const std::size_t word      = is64 ? 8u : 4u;
+    const std::size_t shentsize = is64 ? 64u : 40u;
+    put(is64 ? 40u : 32u, 0x200u,    word);
+    put(is64 ? 58u : 46u, shentsize, 2u);
+    put(is64 ? 60u : 48u, 3u,        2u);
+
+    std::size_t pos = 0x100u;
+    auto note = [&](std::uint32_t type, std::size_t descsz)
+                {
+                    put(pos,      4u,     4u);
+                    put(pos + 4u, descsz, 4u);
+                    put(pos + 8u, type,   4u);
+                    f[pos + 12u] = 'G'; f[pos + 13u] = 'N'; f[pos + 14u] = 'U';
+                    for (std::size_t i = 0u; i < descsz; i++)
+                        f[pos + 16u + i] = static_cast<std::uint8_t>(i + 1u);
+                    pos += 16u + ((descsz + 3u) & ~std::size_t(3u));
+                };
+    note(1u, 16u); //NT_GNU_ABI_TAG
+    if (with_build_id)
+        note(3u, 20u);
+
+    auto section = [&](std::size_t idx, std::uint32_t type, std::uint64_t offset, std::uint64_t size)
+                   {
+                       auto sh = 0x200u + idx * shentsize;
+                       put(sh + 4u, type, 4u);
+                       put(sh + (is64 ? 24u : 16u), offset, word);
+                       put(sh + (is64 ? 32u : 20u), size,   word);
+                   };
+    section(1u, 1u, 0x40u,  0x10u);              //SHT_PROGBITS
+    section(2u, 7u, 0x100u, pos - 0x100u);       //SHT_NOTE
+    return f;
+}
+
+static void write_file(const fs::path & path, const std::vector<std::uint8_t> & data)
+{
+    fs::ofstream os{path, std::ios::binary | std::ios::trunc};
+    os.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+BOOST_AUTO_TEST_CASE(build_id)
+{
+    temp_dir dir;
+    const std::string expected = "0102030405060708090a0b0c0d0e0f1011121314";
+
+    for (bool is64 : {false, true})
+        for (bool big_endian : {false, true})
+        {
+            auto path = dir.path / ("elf" + std::to_string(is64 ? 64 : 32) + (big_endian ? "be" : "le"));
+            write_file(path, make_elf(is64, big_endian));
+            BOOST_CHECK_MESSAGE(gdb::arg_cache::build_id(path) == expected, path);
+        }
+
+    write_file(dir.path / "no-id", make_elf(true, false, false));
+    BOOST_CHECK(gdb::arg_cache::build_id(dir.path / "no-id").empty());
+
+    write_file(dir.path / "not-elf", {'#', '!', '/', 'b', 'i', 'n'});
+    BOOST_CHECK(gdb::arg_cache::build_id(dir.path / "not-elf").empty());
+    BOOST_CHECK(gdb::arg_cache::build_id(dir.path / "missing").empty());
+
+    //a broken section table must not be read beyond the file.
+    auto cut = make_elf(true, false);
+    cut.resize(0x210u);
+    write_file(dir.path / "cut", cut);
+    BOOST_CHECK(gdb::arg_cache::build_id(dir.path / "cut").empty());
+
+#if defined(__linux__)
+    //the test itself is linked with a build-id.
+    auto self = gdb::arg_cache::build_id(boost::unit_test::framework::master_test_suite().argv[0]);
+    BOOST_CHECK(!self.empty());
+    BOOST_CHECK(self.find_first_not_of("0123456789abcdef") == std::string::npos);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(key)
+{
+    temp_dir dir;
+    write_file(dir.path / "exe", make_elf(true, false));
+
+    auto key = gdb::arg_cache::key(dir.path / "exe");
+    BOOST_CHECK_EQUAL(key.substr(0, 41), "0102030405060708090a0b0c0d0e0f1011121314 ");
+    BOOST_CHECK(gdb::arg_cache::key(dir.path / "missing").empty());
+
+    write_file(dir.path / "script", {'#', '!'});
+    BOOST_CHECK_EQUAL(gdb::arg_cache::key(dir.path / "script").substr(0, 4), "- 2 ");
+}
+
+BOOST_AUTO_TEST_CASE(load_save)
+{
+    temp_dir dir;
+    auto file = dir.path / "args.cache";
+
+    gdb::arg_cache ac;
+    BOOST_CHECK(!ac.modified());
+    ac.add(0x400b46u, {"argc", "argv"});
+    ac.add(0x400c00u, {});
+    BOOST_CHECK(ac.modified());
+    BOOST_REQUIRE(ac.save(file, "key-1"));
+    BOOST_CHECK(!ac.modified());
+    BOOST_CHECK(!fs::exists(dir.path / "args.cache.tmp"));
+
+    gdb::arg_cache loaded;
+    BOOST_REQUIRE(loaded.load(file, "key-1"));
+    BOOST_CHECK(!loaded.modified());
+    auto names = loaded.find(0x400b46u);
+    BOOST_REQUIRE(names);
+    BOOST_REQUIRE_EQUAL(names->size(), 2u);
+    BOOST_CHECK_EQUAL((*names)[0], "argc");
+    BOOST_CHECK_EQUAL((*names)[1], "argv");
+    BOOST_REQUIRE(loaded.find(0x400c00u));
+    BOOST_CHECK(loaded.find(0x400c00u)->empty());
+    BOOST_CHECK(!loaded.find(0x400000u));
+
+    //another executable, or a modified one.
+    gdb::arg_cache other;
+    BOOST_CHECK(!other.load(file, "key-2"));
+    BOOST_CHECK(!other.load(file, ""));
+    BOOST_CHECK(!other.load(dir.path / "missing", "key-1"));
+    BOOST_CHECK(!other.find(0x400b46u));
+
+    write_file(dir.path / "garbage", {'x', '\n'});
+    BOOST_CHECK(!other.load(dir.path / "garbage", "key-1"));
+}
+
+BOOST_AUTO_TEST_CASE(failed_save)
+{
+    temp_dir dir;
+    auto file = dir.path / "args.cache";
+
+    gdb::arg_cache ac;
+    ac.add(0x1000u, {"x"});
+    BOOST_REQUIRE(ac.save(file, "key-1"));
+
+    //without a key, i.e. the executable is missing, the stored cache is kept.
+    gdb::arg_cache empty;
+    BOOST_CHECK(!empty.save(file, ""));
+    gdb::arg_cache loaded;
+    BOOST_REQUIRE(loaded.load(file, "key-1"));
+    BOOST_CHECK(loaded.find(0x1000u));
+
+    //the directory doesn't exist.
+    ac.add(0x2000u, {"y"});
+    BOOST_CHECK(!ac.save(dir.path / "no-such-dir" / "args.cache", "key-1"));
+    BOOST_CHECK(ac.modified());
+
+    //the temporary file can't replace the target, so it's removed again.
+    fs::create_directory(dir.path / "dir.cache");
+    BOOST_CHECK(!ac.save(dir.path / "dir.cache", "key-1"));
+    BOOST_CHECK(!fs::exists(dir.path / "dir.cache.tmp"));
+    BOOST_CHECK(ac.modified());
+}
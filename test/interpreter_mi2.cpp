@@ -125,6 +125,111 @@ void BOOST_PP_CAT(mw_test_,  BOOST_PP_VARIADIC_ELEM(0, __VA_ARGS__) ) (mw::gdb::
 
 BOOST_GLOBAL_FIXTURE(MyProcess);
 
+MW_TEST_CASE( pipeline )
+{
+    std::vector<std::string> values;
+    bool got_error = false;
+
+    auto eval = [&](const mi2::result_output & rc)
+                {
+                    BOOST_REQUIRE(rc.class_ == mi2::result_class::done);
+                    values.push_back(mi2::find(rc.results, "value").as_string());
+                };
+
+    mi.pipeline("-data-evaluate-expression 1+1", eval);
+    mi.pipeline("-data-evaluate-expression no_such_symbol_in_target",
+                [&](const mi2::result_output & rc)
+                {
+                    got_error = rc.class_ == mi2::result_class::error;
+                });
+    mi.pipeline("-data-evaluate-expression 2*21", eval);
+    mi.pipeline("-gdb-set confirm off");
+
+    BOOST_CHECK_EQUAL(mi.pipelined(), 4u);
+    BOOST_CHECK_NO_THROW(mi.flush());
+    BOOST_CHECK_EQUAL(mi.pipelined(), 0u);
+
+    BOOST_CHECK(got_error);
+    BOOST_REQUIRE_EQUAL(values.size(), 2u);
+    BOOST_CHECK_EQUAL(values[0], "2");
+    BOOST_CHECK_EQUAL(values[1], "42");
+
+    mi.pipeline("-data-evaluate-expression no_such_symbol_in_target");
+    mi.pipeline("-data-evaluate-expression 1+1", eval);
+    BOOST_CHECK_THROW(mi.flush(), mi2::exception);
+    BOOST_CHECK_EQUAL(values.size(), 3u);
+
+    //a handler throwing with more commands in flight must not leave replies behind.
+    mi.pipeline("-data-evaluate-expression 3+3",
+                [](const mi2::result_output &)
+                {
+                    throw std::runtime_error("handler failed");
+                });
+    for (int i = 0; i < 8; i++)
+        mi.pipeline("-data-evaluate-expression 1+1", eval);
+    BOOST_CHECK_THROW(mi.flush(), std::runtime_error);
+    BOOST_CHECK_EQUAL(mi.pipelined(), 0u);
+
+    //the interpreter is still in sync afterwards.
+    BOOST_CHECK_EQUAL(mi.data_evaluate_expression("5*5"), "25");
+
+    //a failure while reading the replies drops the rest of the pipeline, the replies in flight are read and ignored.
+    {
+        bool thrown = false;
+        boost::signals2::scoped_connection conn = mi.stream_console_sig().connect(
+                [&](const std::string &)
+                {
+                    if (thrown)
+                        return;
+                    thrown = true;
+                    throw std::runtime_error("console failed");
+                });
+
+        auto before = values.size();
+        mi.pipeline("-interpreter-exec console \"echo drain\"");
+        for (int i = 0; i < 8; i++)
+            mi.pipeline("-data-evaluate-expression 1+1", eval);
+        BOOST_CHECK_THROW(mi.flush(), std::runtime_error);
+        BOOST_CHECK(thrown);
+        BOOST_CHECK_EQUAL(mi.pipelined(), 0u);
+        BOOST_CHECK_EQUAL(values.size(), before);
+    }
+    BOOST_CHECK_EQUAL(mi.data_evaluate_expression("6*7"), "42");
+}
+
+MW_TEST_CASE( chunked_memory )
+{
+    //the exe isn't running, so this is read from the file.
+    auto addr = std::stoull(mi.data_evaluate_expression("(unsigned long long)&main"));
+
+    std::vector<std::uint8_t> whole;
+    for (auto & rm : mi.data_read_memory_bytes(std::to_string(addr), 200u))
+    {
+        whole.resize(rm.offset + rm.contents.size());
+        std::copy(rm.contents.begin(), rm.contents.end(), whole.begin() + rm.offset);
+    }
+    BOOST_REQUIRE_EQUAL(whole.size(), 200u);
+
+    std::vector<std::uint8_t> chunked(200u);
+    BOOST_CHECK_EQUAL(mi.data_read_memory_bytes(addr, chunked.size(), chunked.data(), 7u), 200u);
+    BOOST_CHECK_EQUAL_COLLECTIONS(chunked.begin(), chunked.end(), whole.begin(), whole.end());
+
+    std::vector<std::uint8_t> streamed;
+    auto next = addr;
+    BOOST_CHECK_EQUAL(mi.data_read_memory_bytes(addr, std::uint64_t(200u), 64u,
+                        [&](std::uint64_t address, const std::uint8_t * data, std::size_t size)
+                        {
+                            BOOST_CHECK_EQUAL(address, next);
+                            BOOST_CHECK_LE(size, 64u);
+                            streamed.insert(streamed.end(), data, data + size);
+                            next += size;
+                        }), 200u);
+    BOOST_CHECK_EQUAL_COLLECTIONS(streamed.begin(), streamed.end(), whole.begin(), whole.end());
+
+    std::vector<std::uint8_t> nothing(16u);
+    BOOST_CHECK_THROW(mi.data_read_memory_bytes(0u, nothing.size(), nothing.data(), 4u), mi2::exception);
+}
+
 MW_TEST_CASE( create_bp )
 {
     BOOST_TEST_PASSPOINT();
@@ -187,3 +292,46 @@ MW_TEST_CASE( create_bp )
     }
 }
 
+void pipelined_break_insert_impl(mi2::interpreter & mi)
+{
+    std::vector<int> numbers;
+    std::vector<std::size_t> sizes;
+    std::vector<std::string> errors;
+
+    auto handler = [&](std::vector<mi2::breakpoint> && bps, const std::string & error)
+                   {
+                       if (bps.empty())
+                           errors.push_back(error);
+                       else
+                       {
+                           numbers.push_back(bps.front().number);
+                           sizes.push_back(bps.size());
+                       }
+                   };
+
+    mi.pipeline_break_insert("target.cpp:39", handler);
+    mi.pipeline_break_insert("no_such_function_in_target", handler);
+    mi.pipeline_break_insert("f", handler, std::string("1"));
+    mi.pipeline_dprintf_insert("target.cpp:39", "\"trace %d\\n\"", {"42"}, handler);
+
+    BOOST_CHECK_EQUAL(mi.pipelined(), 4u);
+    BOOST_CHECK_NO_THROW(mi.flush());
+
+    BOOST_CHECK_EQUAL(errors.size(), 1u);
+    BOOST_REQUIRE_EQUAL(numbers.size(), 3u);
+    BOOST_CHECK_EQUAL(sizes[0], 1u);
+    BOOST_CHECK_GT(sizes[1], 1u); //f is overloaded, so it's the breakpoint and its locations.
+
+    BOOST_CHECK_NO_THROW(mi.break_delete(numbers));
+}
+
+//create_bp exits the shared gdb and relies on its breakpoint numbers, so this test starts its own.
+BOOST_AUTO_TEST_CASE( pipelined_break_insert )
+{
+    auto shared = MyProcess::proc;
+    {
+        MyProcess own;
+        own.run(pipelined_break_insert_impl);
+    }
+    MyProcess::proc = shared;
+}
@@ -0,0 +1,437 @@
+/**
+ * @file   /gdb-runner/test/memory.cpp
+ * @date   16.10.2026
+ * @author Klemens D. Morgenstern
+ *
+ * Published under [Apache License 2.0](http://www.apache.org/licenses/LICENSE-2.0.html)
+  <pre>
+    /  /|  (  )   |  |  /
+   /| / |   \/    | /| /
+  / |/  |   /\    |/ |/
+ /  /   |  (  \   /  |
+               ) 
+</pre>
+ */
+
+#include <mw/gdb/memory_dump.hpp>
+#include <mw/gdb/memory_map.hpp>
+#include <mw/gdb/shadow_memory.hpp>
+#include <mw/gdb/mi2/page_cache.hpp>
+
+#define BOOST_TEST_MODULE memory_test
+#define BOOST_TEST_NO_LIB
+
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <iterator>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gdb = mw::gdb;
+namespace mi2 = mw::gdb::mi2;
+namespace fs  = boost::filesystem;
+
+BOOST_AUTO_TEST_CASE(info_mem)
+{
+    auto mp = gdb::memory_map::from_info_mem(
+            "Using memory regions provided by the target.\n"
+            "Num Enb Low Addr   High Addr  Attrs \n"
+            "0   y   0x00000000 0x00040000 ro nocache \n"
+            "1   y   0x20000000 0x20010000 rw cache \n"
+            "2   n   0x30000000 0x30001000 rw nocache \n"
+            "3   y   0x40000000 0x40001000 wo nocache \n"
+            "4   y   0xe0000000 0x00000000 rw nocache \n");
+
+    BOOST_REQUIRE_EQUAL(mp.regions().size(), 3u);
+    BOOST_CHECK_EQUAL(mp.regions()[0].begin, 0u);
+    BOOST_CHECK_EQUAL(mp.regions()[0].end,   0x40000u);
+    BOOST_CHECK_EQUAL(mp.regions()[1].begin, 0x20000000u);
+    BOOST_CHECK_EQUAL(mp.regions()[1].end,   0x20010000u);
+    BOOST_CHECK_EQUAL(mp.regions()[2].begin, 0xe0000000u);
+    BOOST_CHECK_EQUAL(mp.regions()[2].end,   std::numeric_limits<std::uint64_t>::max()); //up to the end
+
+    BOOST_CHECK(!mp.regions()[0].cache);
+    BOOST_CHECK( mp.regions()[1].cache);
+    BOOST_CHECK(!mp.cacheable(0x3ff00u,    0x200u));
+    BOOST_CHECK( mp.cacheable(0x20000000u, 0x100u));
+    BOOST_CHECK( mp.cacheable(0x40000u,    0x100u)); //not mapped at all
+
+    BOOST_CHECK(gdb::memory_map::from_info_mem("There are no memory regions defined.\n").empty());
+}
+
+BOOST_AUTO_TEST_CASE(proc_maps)
+{
+    std::istringstream is{
+        "00400000-00452000 r-xp 00000000 08:02 173521      /usr/bin/dbus-daemon\n"
+        "00651000-00652000 r--p 00051000 08:02 173521      /usr/bin/dbus-daemon\n"
+        "00652000-00655000 rw-p 00052000 08:02 173521      /usr/bin/dbus-daemon\n"
+        "7ffd3b5e2000-7ffd3b5e4000 ---p 00000000 00:00 0\n"
+        "garbage\n"
+        "7ffd3b5e4000-7ffd3b5e6000 r-xp 00000000 00:00 0   [vdso]\n"};
+
+    auto mp = gdb::memory_map::from_proc_maps(is);
+    BOOST_REQUIRE_EQUAL(mp.regions().size(), 4u);
+    BOOST_CHECK_EQUAL(mp.regions()[0].begin, 0x400000u);
+    BOOST_CHECK_EQUAL(mp.regions()[1].end,   0x652000u);
+    BOOST_CHECK_EQUAL(mp.regions()[3].begin, 0x7ffd3b5e4000u);
+    BOOST_CHECK_EQUAL(mp.regions()[3].end,   0x7ffd3b5e6000u);
+
+    //the adjacent regions are read without a gap.
+    BOOST_CHECK_EQUAL(mp.readable(0x651800u, 0x1000u), 0x1000u);
+    BOOST_CHECK_EQUAL(mp.readable(0x654800u, 0x1000u), 0x800u);
+    BOOST_CHECK_EQUAL(mp.readable(0x7ffd3b5e2000u, 0x10u), 0u);
+
+    //code might hold breakpoints, so it's not accessed directly.
+    BOOST_CHECK( mp.regions()[0].exec);
+    BOOST_CHECK(!mp.regions()[1].exec);
+    BOOST_CHECK( mp.regions()[3].exec);
+    BOOST_CHECK( mp.executable(0x451ff0u, 0x100u));
+    BOOST_CHECK(!mp.executable(0x452000u, 0x203000u));
+    BOOST_CHECK( mp.executable(0x7ffd3b5e3000u, 0x2000u));
+}
+
+BOOST_AUTO_TEST_CASE(segments)
+{
+    gdb::memory_map mp;
+    BOOST_CHECK(mp.empty());
+
+    //an unknown map reads everything in one go.
+    auto seg = mp.segments(0x1234u, 0x100u);
+    BOOST_REQUIRE_EQUAL(seg.size(), 1u);
+    BOOST_CHECK_EQUAL(seg[0].first,  0x1234u);
+    BOOST_CHECK_EQUAL(seg[0].second, 0x100u);
+
+    mp.add(0x2000u, 0x3000u);
+    mp.add(0x1000u, 0x2000u);
+    mp.add(0x4000u, 0x5000u);
+    mp.add(0x6000u, 0x6000u); //empty, ignored
+    BOOST_REQUIRE_EQUAL(mp.regions().size(), 3u);
+    BOOST_CHECK_EQUAL(mp.regions()[0].begin, 0x1000u);
+
+    seg = mp.segments(0x1800u, 0x1000u);
+    BOOST_REQUIRE_EQUAL(seg.size(), 2u);
+    BOOST_CHECK_EQUAL(seg[0].first,  0x1800u);
+    BOOST_CHECK_EQUAL(seg[0].second, 0x800u);
+    BOOST_CHECK_EQUAL(seg[1].first,  0x2000u);
+    BOOST_CHECK_EQUAL(seg[1].second, 0x800u);
+
+    //stops at the gap.
+    seg = mp.segments(0x2800u, 0x2000u);
+    BOOST_REQUIRE_EQUAL(seg.size(), 1u);
+    BOOST_CHECK_EQUAL(seg[0].second, 0x800u);
+
+    BOOST_CHECK(mp.segments(0x0800u, 0x1000u).empty());
+    BOOST_CHECK(mp.segments(0x3000u, 0x10u).empty());
+    BOOST_CHECK(mp.segments(0x6000u, 0x10u).empty());
+
+    //doesn't overflow at the end of the address space.
+    mp.add(0xffffffffffff0000u, std::numeric_limits<std::uint64_t>::max());
+    seg = mp.segments(0xfffffffffffffff0u, 0x100u);
+    BOOST_REQUIRE_EQUAL(seg.size(), 1u);
+    BOOST_CHECK_EQUAL(seg[0].second, 0xfu);
+}
+
+//target memory for the page cache, which logs the requests and is only readable up to end.
+struct fake_target
+{
+    std::uint64_t end;
+    std::uint64_t max_request = std::numeric_limits<std::uint64_t>::max();
+    std::vector<std::pair<std::uint64_t, std::size_t>> requests;
+
+    explicit fake_target(std::uint64_t end) : end(end) {}
+
+    std::vector<std::uint8_t> operator()(std::uint64_t addr, std::size_t size)
+    {
+        requests.emplace_back(addr, size);
+        if (size > max_request)
+            throw std::runtime_error("request too large");
+
+        std::vector<std::uint8_t> res;
+        for (auto a = addr; (a < addr + size) && (a < end); a++)
+            res.push_back(static_cast<std::uint8_t>(a));
+        return res;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(page_cache)
+{
+    fake_target tg{0x1000u};
+    mi2::page_cache cache{0x100u, 1u};
+
+    auto data = cache.read(0x110u, 4u, std::ref(tg));
+    BOOST_CHECK((data == std::vector<std::uint8_t>{0x10, 0x11, 0x12, 0x13}));
+    BOOST_REQUIRE_EQUAL(tg.requests.size(), 1u);
+    BOOST_CHECK_EQUAL(tg.requests[0].first,  0x100u);
+    BOOST_CHECK_EQUAL(tg.requests[0].second, 0x200u); //the page & the read-ahead
+    BOOST_CHECK_EQUAL(cache.size(), 2u);
+
+    //crossing into the read-ahead is a hit.
+    data = cache.read(0x1feu, 4u, std::ref(tg));
+    BOOST_CHECK((data == std::vector<std::uint8_t>{0xfe, 0xff, 0x00, 0x01}));
+    BOOST_CHECK_EQUAL(tg.requests.size(), 1u);
+
+    cache.invalidate();
+    BOOST_CHECK_EQUAL(cache.size(), 0u);
+    cache.read(0x110u, 4u, std::ref(tg));
+    BOOST_CHECK_EQUAL(tg.requests.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(page_cache_short_pages)
+{
+    //the memory ends in the middle of the second page.
+    fake_target tg{0x180u};
+    mi2::page_cache cache{0x100u, 1u};
+
+    auto data = cache.read(0x170u, 0x20u, std::ref(tg));
+    BOOST_CHECK_EQUAL(data.size(), 0x10u);
+    BOOST_CHECK_EQUAL(data.front(), 0x70u);
+    BOOST_CHECK_EQUAL(data.back(),  0x7fu);
+    BOOST_CHECK_EQUAL(cache.size(), 1u);
+
+    //the short page is cached, so it's not asked again.
+    data = cache.read(0x160u, 0x40u, std::ref(tg));
+    BOOST_CHECK_EQUAL(data.size(), 0x20u);
+    BOOST_CHECK_EQUAL(tg.requests.size(), 1u);
+
+    data = cache.read(0x180u, 0x10u, std::ref(tg));
+    BOOST_CHECK(data.empty());
+}
+
+BOOST_AUTO_TEST_CASE(page_cache_read_ahead_fallback)
+{
+    //the target reports an error if the read-ahead is included.
+    fake_target tg{0x1000u};
+    tg.max_request = 0x100u;
+    mi2::page_cache cache{0x100u, 1u};
+
+    auto data = cache.read(0x10u, 4u, std::ref(tg));
+    BOOST_CHECK((data == std::vector<std::uint8_t>{0x10, 0x11, 0x12, 0x13}));
+    BOOST_REQUIRE_EQUAL(tg.requests.size(), 2u);
+    BOOST_CHECK_EQUAL(tg.requests[0].second, 0x200u);
+    BOOST_CHECK_EQUAL(tg.requests[1].first,  0x0u);
+    BOOST_CHECK_EQUAL(tg.requests[1].second, 0x100u);
+    BOOST_CHECK_EQUAL(cache.size(), 1u);
+
+    //if even that fails, the request itself is passed on, so the error is reported.
+    tg.max_request = 4u;
+    BOOST_CHECK_THROW(cache.read(0x210u, 8u, std::ref(tg)), std::runtime_error);
+    BOOST_CHECK_EQUAL(tg.requests.size(), 5u);
+    BOOST_CHECK_EQUAL(tg.requests.back().first,  0x210u);
+    BOOST_CHECK_EQUAL(tg.requests.back().second, 8u);
+}
+
+BOOST_AUTO_TEST_CASE(page_cache_empty_fetch)
+{
+    fake_target tg{0u};
+    mi2::page_cache cache{0x100u, 1u};
+
+    BOOST_CHECK(cache.read(0x10u, 4u, std::ref(tg)).empty());
+    BOOST_CHECK_EQUAL(cache.size(), 0u);
+
+    //nothing is cached, so it's asked again.
+    BOOST_CHECK(cache.read(0x10u, 4u, std::ref(tg)).empty());
+    BOOST_CHECK_EQUAL(tg.requests.size(), 2u);
+
+    //a disabled cache passes everything on.
+    mi2::page_cache disabled{0u};
+    tg.end = 0x100u;
+    BOOST_CHECK_EQUAL(disabled.read(0x10u, 4u, std::ref(tg)).size(), 4u);
+    BOOST_CHECK_EQUAL(tg.requests.back().second, 4u);
+    BOOST_CHECK_EQUAL(disabled.size(), 0u);
+}
+
+static std::vector<std::uint8_t> read_file(const fs::path & path)
+{
+    fs::ifstream fs{path, std::ios::binary};
+    return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(fs), std::istreambuf_iterator<char>());
+}
+
+BOOST_AUTO_TEST_CASE(memory_dump)
+{
+    auto path = fs::temp_directory_path() / fs::unique_path("mw-dump-%%%%-%%%%.bin");
+
+    //three pages, the one in the middle is all zero.
+    std::vector<std::uint8_t> data(3u * 4096u, 0u);
+    for (std::size_t i = 0u; i < 4096u; i++)
+    {
+        data[i] = static_cast<std::uint8_t>(i);
+        data[2u * 4096u + i] = static_cast<std::uint8_t>(~i);
+    }
+
+    for (bool sparse : {true, false})
+    {
+        {
+            gdb::memory_dump dump{path, 0x10000u, data.size(), sparse};
+            BOOST_CHECK_EQUAL(fs::file_size(path), data.size());
+            //written in two chunks, which don't start at a page boundary.
+            dump.write(0x10000u, data.data(), 100u);
+            dump.write(0x10000u + 100u, data.data() + 100u, data.size() - 100u);
+            dump.finish(data.size());
+        }
+        auto content = read_file(path);
+        BOOST_CHECK_EQUAL_COLLECTIONS(content.begin(), content.end(), data.begin(), data.end());
+    }
+
+    //only the beginning is readable, so the file is cut.
+    {
+        gdb::memory_dump dump{path, 0x10000u, data.size()};
+        dump.write(0x10000u, data.data(), 5000u);
+        dump.finish(5000u);
+    }
+    auto content = read_file(path);
+    BOOST_CHECK_EQUAL(fs::file_size(path), 5000u);
+    BOOST_CHECK_EQUAL_COLLECTIONS(content.begin(), content.end(), data.begin(), data.begin() + 5000u);
+
+    //an existing file is truncated.
+    {
+        gdb::memory_dump dump{path, 0x10000u, 16u};
+        dump.finish(0u);
+    }
+    BOOST_CHECK_EQUAL(fs::file_size(path), 0u);
+
+    fs::remove(path);
+
+    BOOST_CHECK_THROW(gdb::memory_dump(fs::temp_directory_path() / "no-such-dir" / "dump.bin", 0u, 16u), std::exception);
+}
+
+//the ranges as found by comparing byte by byte, merged like diff_memory does.
+static std::vector<mw::debug::memory_range> naive_diff(const std::vector<std::uint8_t> & old, const std::vector<std::uint8_t> & now, std::uint64_t addr)
+{
+    std::vector<mw::debug::memory_range> res;
+    for (std::size_t i = 0u; i < old.size(); i++)
+        if (old[i] != now[i])
+        {
+            if (!res.empty() && (res.back().addr + res.back().size == addr + i))
+                res.back().size++;
+            else
+                res.push_back({addr + i, 1u});
+        }
+    return res;
+}
+
+namespace mw { namespace debug {
+
+//found by ADL, for the checks.
+static bool operator==(const memory_range & lhs, const memory_range & rhs) {return (lhs.addr == rhs.addr) && (lhs.size == rhs.size);}
+static bool operator!=(const memory_range & lhs, const memory_range & rhs) {return !(lhs == rhs);}
+
+static std::ostream & operator<<(std::ostream & os, const memory_range & mr)
+{
+    return os << "[0x" << std::hex << mr.addr << std::dec << ", " << mr.size << "]";
+}
+
+}}
+
+BOOST_AUTO_TEST_CASE(diff_memory_blocks)
+{
+    //differences right before, at and after the boundaries of the 16 & 32 byte blocks.
+    std::vector<std::uint8_t> old(100u);
+    for (std::size_t i = 0u; i < old.size(); i++)
+        old[i] = static_cast<std::uint8_t>(i * 7u);
+
+    for (std::size_t size : {1u, 15u, 16u, 17u, 31u, 32u, 33u, 47u, 48u, 63u, 64u, 65u, 100u})
+        for (std::size_t pos : {0u, 14u, 15u, 16u, 17u, 30u, 31u, 32u, 33u, 47u, 48u, 63u, 64u, 99u})
+            for (std::size_t len : {1u, 2u, 3u, 18u, 34u})
+            {
+                if (pos >= size)
+                    continue;
+
+                std::vector<std::uint8_t> a(old.begin(), old.begin() + size);
+                auto b = a;
+                for (auto i = pos; i < (std::min)(pos + len, size); i++)
+                    b[i] ^= 0x5a;
+                b[size - 1u] ^= 0x01; //the tail is done bytewise
+
+                std::vector<mw::debug::memory_range> res;
+                gdb::diff_memory(a.data(), b.data(), size, 0x1000u, res);
+                auto expected = naive_diff(a, b, 0x1000u);
+                BOOST_CHECK_EQUAL_COLLECTIONS(res.begin(), res.end(), expected.begin(), expected.end());
+            }
+
+    //a difference crossing a block boundary is one range.
+    std::vector<std::uint8_t> a(64u, 0u), b(64u, 0u);
+    b[31] = b[32] = 1u;
+    b[15] = b[16] = 2u;
+    std::vector<mw::debug::memory_range> res;
+    gdb::diff_memory(a.data(), b.data(), a.size(), 0u, res);
+    BOOST_REQUIRE_EQUAL(res.size(), 2u);
+    BOOST_CHECK_EQUAL(res[0], (mw::debug::memory_range{15u, 2u}));
+    BOOST_CHECK_EQUAL(res[1], (mw::debug::memory_range{31u, 2u}));
+
+    res.clear();
+    gdb::diff_memory(a.data(), a.data(), a.size(), 0u, res);
+    BOOST_CHECK(res.empty());
+}
+
+BOOST_AUTO_TEST_CASE(shadow_memory_update)
+{
+    gdb::shadow_memory sm;
+    BOOST_CHECK(sm.empty());
+    BOOST_CHECK(sm.update(0x100u, {1, 2, 3}).empty()); //not watched
+
+    //only the first 40 bytes were readable when it was watched.
+    sm.watch(0x100u, 64u, std::vector<std::uint8_t>(40u, 0u));
+    BOOST_CHECK(sm.watched(0x100u));
+    BOOST_CHECK_EQUAL(sm.size(0x100u), 64u);
+
+    std::vector<std::uint8_t> now(64u, 0u);
+    now[39] = 1u;
+    auto res = sm.update(0x100u, now);
+    BOOST_REQUIRE_EQUAL(res.size(), 1u);
+    BOOST_CHECK_EQUAL(res[0], (mw::debug::memory_range{0x100u + 39u, 25u})); //merged with the grown part
+
+    BOOST_CHECK(sm.update(0x100u, now).empty());
+
+    //less is readable now, so the rest of the shadow is kept.
+    now[10] = 2u;
+    res = sm.update(0x100u, std::vector<std::uint8_t>(now.begin(), now.begin() + 20u));
+    BOOST_REQUIRE_EQUAL(res.size(), 1u);
+    BOOST_CHECK_EQUAL(res[0], (mw::debug::memory_range{0x100u + 10u, 1u}));
+    now[50] = 3u;
+    res = sm.update(0x100u, now);
+    BOOST_REQUIRE_EQUAL(res.size(), 1u);
+    BOOST_CHECK_EQUAL(res[0], (mw::debug::memory_range{0x100u + 50u, 1u}));
+
+    sm.unwatch(0x100u);
+    BOOST_CHECK(!sm.watched(0x100u));
+    BOOST_CHECK_EQUAL(sm.size(0x100u), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(shadow_memory_mark)
+{
+    gdb::shadow_memory sm;
+    std::vector<std::uint8_t> data(64u, 0u);
+    sm.watch(0x100u, data.size(), data);
+    sm.watch(0x200u, data.size(), data);
+
+    //writes of unchanged values are reported, clipped to the region and merged with the differences.
+    sm.mark(0x0f0u, 0x14u);       //the first four bytes
+    sm.mark(0x120u, 4u);
+    sm.mark(0x180u, 4u);          //outside both
+    data[0x24] = 1u;              //adjacent to the second write
+    data[0x30] = 1u;
+
+    auto res = sm.update(0x100u, data);
+    BOOST_REQUIRE_EQUAL(res.size(), 3u);
+    BOOST_CHECK_EQUAL(res[0], (mw::debug::memory_range{0x100u, 4u}));
+    BOOST_CHECK_EQUAL(res[1], (mw::debug::memory_range{0x120u, 5u}));
+    BOOST_CHECK_EQUAL(res[2], (mw::debug::memory_range{0x130u, 1u}));
+
+    //the writes are only reported once.
+    BOOST_CHECK(sm.update(0x100u, data).empty());
+
+    //the other region didn't see any of them.
+    BOOST_CHECK(sm.update(0x200u, std::vector<std::uint8_t>(64u, 0u)).empty());
+
+    //watching again drops the recorded writes.
+    sm.mark(0x200u, 8u);
+    sm.watch(0x200u, 64u, std::vector<std::uint8_t>(64u, 0u));
+    BOOST_CHECK(sm.update(0x200u, std::vector<std::uint8_t>(64u, 0u)).empty());
+}
@@ -15,6 +15,8 @@
 
 #include <boost/optional/optional_io.hpp>
 #include <mw/gdb/mi2/output.hpp>
+#include <mw/gdb/mi2/types.hpp>
+#include <mw/gdb/mi2/hex.hpp>
 #include <boost/variant/get.hpp>
 
 #define BOOST_TEST_MODULE parser_test
@@ -156,9 +158,9 @@ BOOST_AUTO_TEST_CASE(sync_output)
     BOOST_REQUIRE(tup[9].value_.type() == boost::typeindex::type_id<mi2::list>());
     auto &l = boost::get<mi2::list>(tup[9].value_);
 
-    BOOST_REQUIRE(l.type() == boost::typeindex::type_id<std::vector<mi2::value>>());
+    BOOST_REQUIRE(l.type() == boost::typeindex::type_id<mi2::value_list>());
 
-    auto v = boost::get<std::vector<mi2::value>>(l);
+    auto v = boost::get<mi2::value_list>(l);
     BOOST_REQUIRE_EQUAL(v.size(), 1u);
 
     BOOST_REQUIRE(v[0].type() == boost::typeindex::type_id<std::string>());
@@ -185,3 +187,285 @@ BOOST_AUTO_TEST_CASE(sync_output3)
     BOOST_CHECK(!mi2::parse_record(1, str));
 
 }
+
+BOOST_AUTO_TEST_CASE(line_dispatch)
+{
+    mi2::output_line ol;
+
+    BOOST_CHECK_EQUAL(mi2::parse_line("~\"stuff\"", ol), mi2::output_line::stream);
+    BOOST_CHECK(!ol.token);
+    BOOST_CHECK_EQUAL(ol.stream_data.content, "stuff");
+    BOOST_CHECK_EQUAL(ol.stream_data.type, mi2::stream_record::console);
+
+    BOOST_CHECK_EQUAL(mi2::parse_line("42*stopped,reason=\"exited-normally\"", ol), mi2::output_line::async);
+    BOOST_REQUIRE(ol.token);
+    BOOST_CHECK_EQUAL(*ol.token, 42u);
+    BOOST_CHECK_EQUAL(ol.async_data.type, mi2::async_output::exec);
+    BOOST_CHECK_EQUAL(ol.async_data.class_, "stopped");
+    BOOST_REQUIRE_EQUAL(ol.async_data.results.size(), 1u);
+    BOOST_CHECK_EQUAL(ol.async_data.results[0].variable, "reason");
+
+    //reusing the object must not keep the results of the previous line.
+    BOOST_CHECK_EQUAL(mi2::parse_line("*running,thread-id=\"all\"", ol), mi2::output_line::async);
+    BOOST_CHECK(!ol.token);
+    BOOST_CHECK_EQUAL(ol.async_data.class_, "running");
+    BOOST_CHECK_EQUAL(ol.async_data.results.size(), 1u);
+
+    BOOST_CHECK_EQUAL(mi2::parse_line("7^done,value=\"2\"\r", ol), mi2::output_line::result);
+    BOOST_REQUIRE(ol.token);
+    BOOST_CHECK_EQUAL(*ol.token, 7u);
+    BOOST_CHECK(ol.result_data.class_ == mi2::result_class::done);
+    BOOST_REQUIRE_EQUAL(ol.result_data.results.size(), 1u);
+    BOOST_CHECK_EQUAL(ol.result_data.results[0].value_.as_string(), "2");
+
+    BOOST_CHECK_EQUAL(mi2::parse_line("(gdb) ", ol), mi2::output_line::prompt);
+    BOOST_CHECK_EQUAL(mi2::parse_line("hello world", ol), mi2::output_line::unknown);
+    BOOST_CHECK_EQUAL(mi2::parse_line("12", ol), mi2::output_line::unknown);
+    BOOST_CHECK_EQUAL(mi2::parse_line("", ol), mi2::output_line::unknown);
+    BOOST_CHECK_EQUAL(mi2::parse_line("^bogus", ol), mi2::output_line::unknown);
+
+    std::string buffer = "~\"first\"\n^done\n";
+    BOOST_CHECK_EQUAL(mi2::parse_line(boost::string_view(buffer.data(), 9u), ol), mi2::output_line::stream);
+    BOOST_CHECK_EQUAL(ol.stream_data.content, "first");
+}
+
+BOOST_AUTO_TEST_CASE(arena_results)
+{
+    mi2::arena ar;
+    mi2::result_output copy;
+    {
+        mi2::output_line ol{ar};
+        BOOST_REQUIRE_EQUAL(mi2::parse_line(R"__(3^done,stack=[frame={level="0",addr="0x00000000004015b8",func="f"},frame={level="1",addr="0x0000000000401608",func="main"}],groups=["i1","i2"])__", ol), mi2::output_line::result);
+
+        auto & res = ol.result_data.results;
+        BOOST_CHECK(res.get_allocator().resource() == &ar);
+        BOOST_REQUIRE_EQUAL(res.size(), 2u);
+
+        auto & frames = res[0].value_.as_list().as_results();
+        BOOST_CHECK(frames.get_allocator().resource() == &ar);
+        BOOST_REQUIRE_EQUAL(frames.size(), 2u);
+        BOOST_CHECK(frames[1].value_.as_tuple().get_allocator().resource() == &ar);
+        BOOST_CHECK_EQUAL(frames[1].value_.as_tuple()[2].value_.as_string(), "main");
+
+        BOOST_CHECK(ar.capacity() > 0u);
+
+        //copies don't refer to the arena, so they can outlive it.
+        copy = ol.result_data;
+        BOOST_CHECK(copy.results.get_allocator().resource() == nullptr);
+        BOOST_CHECK(copy.results[0].value_.as_list().as_results().get_allocator().resource() == nullptr);
+
+        //moves keep the arena, so the moved results must not outlive it.
+        mi2::result_output moved;
+        moved = std::move(ol.result_data);
+        BOOST_CHECK(moved.results.get_allocator().resource() == &ar);
+        BOOST_CHECK(moved.results[0].value_p.get_deleter().resource == &ar);
+        BOOST_CHECK(moved.results[0].value_.as_list().as_results().get_allocator().resource() == &ar);
+    }
+    ar.reset();
+
+    auto & groups = copy.results[1].value_.as_list().as_values();
+    BOOST_REQUIRE_EQUAL(groups.size(), 2u);
+    BOOST_CHECK_EQUAL(groups[1].as_string(), "i2");
+}
+
+BOOST_AUTO_TEST_CASE(interned_keys)
+{
+    BOOST_CHECK(mi2::intern("thread-groups") == mi2::key::thread_groups);
+    BOOST_CHECK(mi2::intern("no-such-key")   == mi2::key::unknown);
+    BOOST_CHECK_EQUAL(mi2::key_name(mi2::key::original_location), "original-location");
+
+    auto res = mi2::parse_record(R"__(5^done,bkpt={number="1",original-location="target.cpp:34",some-new-field="x"},"i1")__");
+    BOOST_REQUIRE(res);
+    auto & r = res->second.results;
+    BOOST_REQUIRE_EQUAL(r.size(), 2u);
+    BOOST_CHECK(r[0].key_ == mi2::key::bkpt);
+
+    auto & tup = r[0].value_.as_tuple();
+    BOOST_REQUIRE_EQUAL(tup.size(), 3u);
+    BOOST_CHECK(tup[0].key_ == mi2::key::number);
+    BOOST_CHECK(tup[1].key_ == mi2::key::original_location);
+    BOOST_CHECK(tup[2].key_ == mi2::key::unknown);
+    BOOST_CHECK_EQUAL(tup[2].variable, "some-new-field");
+}
+
+BOOST_AUTO_TEST_CASE(inherited_names)
+{
+    //unnamed results take the name of the first result, not of a field inside its tuple.
+    auto res = mi2::parse_record(R"__(5^done,bkpt={number="1",some-new-field="x"},{number="1.1"},"i1")__");
+    BOOST_REQUIRE(res);
+    auto & r = res->second.results;
+    BOOST_REQUIRE_EQUAL(r.size(), 3u);
+    BOOST_CHECK(r[0].key_ == mi2::key::bkpt);
+    BOOST_CHECK(r[1].key_ == mi2::key::bkpt);
+    BOOST_CHECK(r[2].key_ == mi2::key::bkpt);
+}
+
+BOOST_AUTO_TEST_CASE(reflected_decode)
+{
+    auto res = mi2::parse_record(R"__(2^done,bkpt={number="1",type="breakpoint",disp="keep",enabled="y",addr="<PENDING>",line="34",line="35",thread-groups=["i1"],times="0"})__");
+    BOOST_REQUIRE(res);
+
+    auto bp = mi2::parse_result<mi2::breakpoint>(mi2::find(res->second.results, mi2::key::bkpt).as_tuple());
+    BOOST_CHECK_EQUAL(bp.number, 1);
+    BOOST_CHECK_EQUAL(bp.type, "breakpoint");
+    BOOST_CHECK(bp.enabled);
+    BOOST_CHECK_EQUAL(bp.addr, 0u);
+    BOOST_CHECK_EQUAL(bp.line, 34); //the first one counts
+    BOOST_REQUIRE(bp.thread_groups);
+    BOOST_CHECK_EQUAL(bp.thread_groups->size(), 1u);
+    BOOST_CHECK(!bp.func);
+
+    auto gr = mi2::parse_record(R"__(3^done,id="i1",type="process",exit-code="010")__");
+    BOOST_REQUIRE(gr);
+    auto g = mi2::parse_result<mi2::groups>(gr->second.results);
+    BOOST_CHECK_EQUAL(g.id, 1);
+    BOOST_CHECK_EQUAL(g.exit_code, 8);
+
+    auto wp = mi2::parse_record(R"__(4^done,exp="x")__");
+    BOOST_REQUIRE(wp);
+    BOOST_CHECK_THROW(mi2::parse_result<mi2::watchpoint>(wp->second.results), mi2::missing_value);
+}
+
+BOOST_AUTO_TEST_CASE(multiple_locations)
+{
+    //as given by gdb 8 with --interpreter mi2 for an overloaded function.
+    auto res = mi2::parse_record(R"__(7^done,bkpt={number="2",type="breakpoint",disp="keep",enabled="y",addr="<MULTIPLE>",times="0",original-location="f"},)__"
+                                 R"__({number="2.1",enabled="y",addr="0x0000000000400b46",func="f(int)",file="target.cpp",fullname="/tmp/target.cpp",line="20",thread-groups=["i1"]},)__"
+                                 R"__({number="2.2",enabled="n",addr="0x0000000000400b5a",func="f(double)",file="target.cpp",fullname="/tmp/target.cpp",line="25",thread-groups=["i1"]})__");
+    BOOST_REQUIRE(res);
+
+    auto bps = mi2::parse_breakpoints(res->second.results);
+    BOOST_REQUIRE_EQUAL(bps.size(), 3u);
+
+    BOOST_CHECK_EQUAL(bps[0].number, 2);
+    BOOST_CHECK_EQUAL(bps[0].addr, 0u);
+    BOOST_CHECK_EQUAL(bps[0].original_location, std::string("f"));
+    BOOST_CHECK(!bps[0].func);
+
+    BOOST_CHECK_EQUAL(bps[1].number, 2);
+    BOOST_CHECK_EQUAL(bps[1].type, "breakpoint");
+    BOOST_CHECK_EQUAL(bps[1].disp, "keep");
+    BOOST_CHECK(bps[1].enabled);
+    BOOST_CHECK_EQUAL(bps[1].addr, 0x400b46u);
+    BOOST_CHECK_EQUAL(bps[1].func,  std::string("f(int)"));
+    BOOST_CHECK_EQUAL(bps[1].line,  20);
+
+    BOOST_CHECK(!bps[2].enabled);
+    BOOST_CHECK_EQUAL(bps[2].addr, 0x400b5au);
+    BOOST_CHECK_EQUAL(bps[2].func,  std::string("f(double)"));
+
+    //the breakpoint itself still needs all of its fields.
+    auto bad = mi2::parse_record(R"__(8^done,bkpt={number="3",enabled="y",addr="0x0000000000400b46"})__");
+    BOOST_REQUIRE(bad);
+    BOOST_CHECK_THROW(mi2::parse_breakpoints(bad->second.results), mi2::missing_value);
+}
+
+BOOST_AUTO_TEST_CASE(cstring_escapes)
+{
+    auto res = mi2::parse_stream_output(R"__(~"line\n\ttab \"quoted\" back\\slash \033[0m \\")__");
+    BOOST_REQUIRE(res);
+    BOOST_CHECK_EQUAL(res->content, "line\n\ttab \"quoted\" back\\slash \033[0m \\");
+
+    //long enough for the vectorized scan, with the quote behind the first block.
+    std::string body(100, 'x');
+    res = mi2::parse_stream_output("@\"" + body + "\\\"" + body + "\"");
+    BOOST_REQUIRE(res);
+    BOOST_CHECK_EQUAL(res->content, body + "\"" + body);
+
+    BOOST_CHECK(!mi2::parse_stream_output("~\"" + body + "\\\""));
+}
+
+BOOST_AUTO_TEST_CASE(breakpoint_hit)
+{
+    auto res = mi2::parse_async_output(R"__(*stopped,reason="breakpoint-hit",disp="keep",bkptno="2",frame={addr="0x0000000000401136",func="f",args=[{name="i",value="42"},{name="p",value="0x0"}],file="target.cpp",fullname="/tmp/target.cpp",line="17",arch="i386:x86-64"},thread-id="1",stopped-threads="all",core="3")__");
+    BOOST_REQUIRE(res);
+
+    mi2::breakpoint_hit hit;
+    BOOST_REQUIRE(mi2::parse_breakpoint_hit(res->second.results, hit));
+    BOOST_CHECK_EQUAL(hit.bkptno, 2);
+    BOOST_CHECK_EQUAL(hit.thread_id, 1);
+    BOOST_CHECK_EQUAL(hit.core, 3);
+    BOOST_REQUIRE(hit.addr);
+    BOOST_CHECK_EQUAL(*hit.addr, 0x401136u);
+    BOOST_CHECK_EQUAL(hit.func, "f");
+    BOOST_CHECK_EQUAL(hit.file, "target.cpp");
+    BOOST_CHECK_EQUAL(hit.line, 17);
+    BOOST_REQUIRE(hit.has_args);
+    BOOST_REQUIRE_EQUAL(hit.args.size(), 2u);
+    BOOST_CHECK_EQUAL(hit.args[0].name,  "i");
+    BOOST_CHECK_EQUAL(hit.args[0].value, "42");
+    BOOST_CHECK_EQUAL(hit.args[1].name,  "p");
+
+    //reused for the next hit, which has no args.
+    res = mi2::parse_async_output(R"__(*stopped,reason="breakpoint-hit",disp="keep",bkptno="1",frame={addr="0x0000000000401000",func="main",args=[]},thread-id="1")__");
+    BOOST_REQUIRE(res);
+    BOOST_REQUIRE(mi2::parse_breakpoint_hit(res->second.results, hit));
+    BOOST_CHECK_EQUAL(hit.bkptno, 1);
+    BOOST_CHECK_EQUAL(hit.func, "main");
+    BOOST_CHECK(hit.file.empty());
+    BOOST_CHECK_EQUAL(hit.line, -1);
+    BOOST_CHECK_EQUAL(hit.core, -1);
+    BOOST_CHECK(hit.has_args);
+    BOOST_CHECK(hit.args.empty());
+}
+
+BOOST_AUTO_TEST_CASE(notify_output)
+{
+    auto res = mi2::parse_async_output(R"__(=thread-group-started,id="i1",pid="4242")__");
+    BOOST_REQUIRE(res);
+    BOOST_CHECK_EQUAL(res->second.type, mi2::async_output::notify);
+    BOOST_CHECK_EQUAL(res->second.class_, "thread-group-started");
+
+    auto tg = mi2::parse_result<mi2::thread_group_started>(res->second.results);
+    BOOST_CHECK_EQUAL(tg.id,  1);
+    BOOST_CHECK_EQUAL(tg.pid, 4242);
+
+    res = mi2::parse_async_output(R"__(+download,section=".text",section-size="4096")__");
+    BOOST_REQUIRE(res);
+    BOOST_CHECK_EQUAL(res->second.type, mi2::async_output::status);
+}
+
+BOOST_AUTO_TEST_CASE(hex_transfer)
+{
+    //long enough for the vectorized paths and a scalar tail.
+    std::vector<std::uint8_t> data(77);
+    for (std::size_t i = 0u; i < data.size(); i++)
+        data[i] = static_cast<std::uint8_t>(i * 37u);
+
+    std::string hex(data.size() * 2, ' ');
+    mi2::hex_encode(data.data(), data.size(), &hex[0]);
+    BOOST_CHECK_EQUAL(hex.substr(0, 8), "00254a6f");
+
+    auto res = mi2::parse_record("5^done,memory=[{begin=\"0x1000\",offset=\"0x0\",end=\"0x104d\",contents=\"" + hex + "\"}]");
+    BOOST_REQUIRE(res);
+    auto mem = mi2::find(res->second.results, mi2::key::memory).as_list().as_values();
+    BOOST_REQUIRE_EQUAL(mem.size(), 1u);
+    auto rm = mi2::parse_result<mi2::read_memory_bytes>(mem[0].as_tuple());
+    BOOST_CHECK_EQUAL_COLLECTIONS(rm.contents.begin(), rm.contents.end(), data.begin(), data.end());
+
+    //upper case is accepted.
+    std::string upper = "DEADBEEF" + std::string(62, '0');
+    std::vector<std::uint8_t> out(upper.size() / 2);
+    BOOST_CHECK(mi2::hex_decode(upper.data(), out.size(), out.data()));
+    BOOST_CHECK_EQUAL(out[0], 0xDEu);
+    BOOST_CHECK_EQUAL(out[3], 0xEFu);
+
+    //an invalid digit is reported, in the vectorized part as well as in the tail.
+    for (auto pos : {0u, 33u, 70u, 153u})
+    {
+        auto garbled = hex;
+        garbled[pos] = 'z';
+        std::vector<std::uint8_t> bytes(data.size());
+        BOOST_CHECK_MESSAGE(!mi2::hex_decode(garbled.data(), bytes.size(), bytes.data()), "invalid digit at " << pos);
+    }
+
+    auto garbled = mi2::parse_record("5^done,memory=[{begin=\"0x1000\",offset=\"0x0\",end=\"0x1002\",contents=\"12g4\"}]");
+    BOOST_REQUIRE(garbled);
+    auto & bad = mi2::find(garbled->second.results, mi2::key::memory).as_list().as_values()[0].as_tuple();
+    BOOST_CHECK_THROW(mi2::parse_result<mi2::read_memory_bytes>(bad), mi2::parser_error);
+
+    auto truncated = mi2::parse_record("5^done,memory=[{begin=\"0x1000\",offset=\"0x0\",end=\"0x1002\",contents=\"123\"}]");
+    BOOST_REQUIRE(truncated);
+    auto & odd = mi2::find(truncated->second.results, mi2::key::memory).as_list().as_values()[0].as_tuple();
+    BOOST_CHECK_THROW(mi2::parse_result<mi2::read_memory_bytes>(odd), mi2::parser_error);
+}
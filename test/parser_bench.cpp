@@ -0,0 +1,251 @@
+/**
+ * @file   /gdb-runner/test/parser_bench.cpp
+ * @date   16.10.2026
+ * @author Klemens D. Morgenstern
+ *
+ * Published under [Apache License 2.0](http://www.apache.org/licenses/LICENSE-2.0.html)
+  <pre>
+    /  /|  (  )   |  |  /
+   /| / |   \/    | /| /
+  / |/  |   /\    |/ |/
+ /  /   |  (  \   /  |
+               )
+</pre>
+ */
+
+#include <mw/gdb/mi2/output.hpp>
+#include <mw/gdb/mi2/types.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace mi2 = mw::gdb::mi2;
+
+//every allocation of the process is counted, so the allocations per record can be reported.
+static std::atomic<std::size_t> allocation_count{0u};
+
+void * operator new(std::size_t size)
+{
+    allocation_count++;
+    if (auto p = std::malloc(size ? size : 1u))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void * p) noexcept {std::free(p);}
+void operator delete(void * p, std::size_t) noexcept {std::free(p);}
+
+struct transcript
+{
+    std::string name;
+    std::vector<std::string> lines;
+    std::size_t bytes = 0u;
+};
+
+transcript load(const std::string & path)
+{
+    std::ifstream fs{path};
+    if (!fs)
+        throw std::runtime_error("cannot open transcript " + path);
+
+    transcript tr;
+    tr.name = path.substr(path.find_last_of("/\\") + 1);
+    std::string line;
+    while (std::getline(fs, line))
+    {
+        tr.bytes += line.size() + 1;
+        tr.lines.push_back(std::move(line));
+    }
+    return tr;
+}
+
+//decode the known results, the same way the interpreter & process do.
+std::size_t decode(const mi2::result_list & results)
+{
+    std::size_t cnt = 0u;
+    for (auto & r : results)
+    {
+        switch (r.key_)
+        {
+        case mi2::key::bkpt:
+            mi2::parse_result<mi2::breakpoint>(r.value_.as_tuple());
+            cnt++;
+            break;
+        case mi2::key::frame:
+            mi2::parse_result<mi2::frame>(r.value_.as_tuple());
+            cnt++;
+            break;
+        case mi2::key::stack:
+            for (auto & f : r.value_.as_list().as_results())
+            {
+                mi2::parse_result<mi2::frame>(f.value_.as_tuple());
+                cnt++;
+            }
+            break;
+        case mi2::key::memory:
+            for (auto & m : r.value_.as_list().as_values())
+            {
+                mi2::parse_result<mi2::read_memory_bytes>(m.as_tuple());
+                cnt++;
+            }
+            break;
+        case mi2::key::lines:
+            for (auto & l : r.value_.as_list().as_values())
+            {
+                mi2::parse_result<mi2::symbol_line>(l.as_tuple());
+                cnt++;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return cnt;
+}
+
+struct stats
+{
+    std::size_t records = 0u;
+    std::size_t decoded = 0u;
+    std::size_t allocations = 0u;
+    double seconds = 0.;
+};
+
+//the string based functions, which are the public parser interface.
+stats replay_strings(const transcript & tr, std::size_t repeat)
+{
+    stats st;
+    auto alloc_start = allocation_count.load();
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0u; i < repeat; i++)
+        for (auto & line : tr.lines)
+        {
+            if (line.empty())
+                continue;
+            switch (line.front())
+            {
+            case '~': case '@': case '&':
+                if (mi2::parse_stream_output(line))
+                    st.records++;
+                break;
+            case '*': case '+': case '=':
+                if (auto ao = mi2::parse_async_output(line))
+                {
+                    st.records++;
+                    st.decoded += decode(ao->second.results);
+                }
+                break;
+            case '(':
+                break;
+            default:
+                if (auto rc = mi2::parse_record(line))
+                {
+                    st.records++;
+                    st.decoded += decode(rc->second.results);
+                }
+                break;
+            }
+        }
+
+    st.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    st.allocations = allocation_count.load() - alloc_start;
+    return st;
+}
+
+//parse_line with an arena, which is what the interpreter uses.
+stats replay_lines(const transcript & tr, std::size_t repeat)
+{
+    stats st;
+    mi2::arena ar;
+    auto alloc_start = allocation_count.load();
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0u; i < repeat; i++)
+        for (auto & line : tr.lines)
+        {
+            mi2::output_line ol{ar};
+            switch (mi2::parse_line(line, ol))
+            {
+            case mi2::output_line::stream:
+                st.records++;
+                break;
+            case mi2::output_line::async:
+                st.records++;
+                st.decoded += decode(ol.async_data.results);
+                break;
+            case mi2::output_line::result:
+                st.records++;
+                st.decoded += decode(ol.result_data.results);
+                break;
+            case mi2::output_line::prompt:
+                ar.reset();
+                break;
+            default:
+                break;
+            }
+        }
+
+    st.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    st.allocations = allocation_count.load() - alloc_start;
+    return st;
+}
+
+void report(const char * mode, const transcript & tr, std::size_t repeat, const stats & st)
+{
+    auto mb = static_cast<double>(tr.bytes * repeat) / (1024. * 1024.);
+    auto records = static_cast<double>(st.records);
+    std::cout << std::left  << std::setw(22) << tr.name
+              << std::setw(8) << mode
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << (mb / st.seconds) << " MB/s"
+              << std::setw(12) << std::setprecision(0) << (records / st.seconds) << " records/s"
+              << std::setw(10) << std::setprecision(2) << (static_cast<double>(st.allocations) / records) << " allocs/record"
+              << std::setw(10) << st.decoded / repeat << " decoded" << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+    std::size_t repeat = 20u;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if ((arg == "--repeat") && (i + 1 < argc))
+            repeat = std::stoul(argv[++i]);
+        else
+            files.push_back(std::move(arg));
+    }
+
+    if (files.empty())
+    {
+        std::cerr << "usage: parser_bench [--repeat N] transcript..." << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        for (auto & f : files)
+        {
+            auto tr = load(f);
+            //warm up, so the first run doesn't pay for the key table & caches.
+            replay_lines(tr, 1u);
+            report("string", tr, repeat, replay_strings(tr, repeat));
+            report("line",   tr, repeat, replay_lines  (tr, repeat));
+        }
+    }
+    catch (std::exception & e)
+    {
+        std::cerr << "parser_bench failed: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
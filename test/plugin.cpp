@@ -2,8 +2,10 @@
 #include <mw/debug/break_point.hpp>
 #include <mw/debug/frame.hpp>
 #include <mw/debug/plugin.hpp>
+#include <cstring>
 #include <vector>
 #include <memory>
+#include <string>
 #include <iostream>
 
 using namespace mw::debug;
@@ -25,6 +27,91 @@ struct f_ptr : break_point
     }
 };
 
+struct h_cache : break_point
+{
+    h_cache() : break_point("h")
+    {
+
+    }
+
+    void invoke(frame & fr, const std::string & file, int line) override
+    {
+        std::cerr << file << "(" << line << "): " << "h" << std::endl;
+
+        //the write is deferred, so reading p[1] caches the page with the old p[0], which must be dropped when the write is done.
+        auto p = std::stoull(fr.arg_list(0).value, nullptr, 16);
+        int one = 1;
+        std::vector<std::uint8_t> data(sizeof(int));
+        std::memcpy(data.data(), &one, sizeof(int));
+
+        fr.write_memory(p, data);
+        fr.read_memory(p + sizeof(int), sizeof(int));
+        if (fr.read_memory(p, sizeof(int)) == data)
+            fr.set("p", 1, "2");
+    }
+};
+
+struct w_failed : break_point
+{
+    w_failed() : break_point("w")
+    {
+
+    }
+
+    void invoke(frame & fr, const std::string & file, int line) override
+    {
+        std::cerr << file << "(" << line << "): " << "w" << std::endl;
+
+        //the write to address 0 fails, but must not drop the one to p[0] queued behind it.
+        auto p = std::stoull(fr.arg_list(0).value, nullptr, 16);
+        int one = 1;
+        std::vector<std::uint8_t> data(sizeof(int));
+        std::memcpy(data.data(), &one, sizeof(int));
+
+        fr.write_memory(0u, data);
+        fr.write_memory(p, data);
+        try
+        {
+            fr.read_memory(p, sizeof(int));
+            return; //the failed write wasn't reported.
+        }
+        catch (std::exception & e)
+        {
+            std::cerr << "Write failed as expected: " << e.what() << std::endl;
+        }
+
+        if (fr.read_memory(p, sizeof(int)) == data)
+            fr.set("p", 1, "2");
+    }
+};
+
+struct s_shadow : break_point
+{
+    s_shadow() : break_point("s")
+    {
+
+    }
+
+    void invoke(frame & fr, const std::string & file, int line) override
+    {
+        std::cerr << file << "(" << line << "): " << "s" << std::endl;
+
+        //the code at the pc holds this breakpoint, so read_memory must give the original bytes, as gdb does when evaluating.
+        auto pc = std::stoull(fr.print("(unsigned long long)$pc").value);
+        auto code = fr.read_memory(pc, 4u);
+        if (code.size() != 4u)
+            return;
+
+        for (std::size_t i = 0u; i < code.size(); i++)
+        {
+            auto byte = std::stoul(fr.print("(unsigned int)*(unsigned char*)" + std::to_string(pc + i)).value);
+            if (byte != code[i])
+                return;
+        }
+        fr.set("ok", "1");
+    }
+};
+
 struct f_ref : break_point
 {
     f_ref() : break_point("f(int&)")
@@ -40,6 +127,22 @@ struct f_ref : break_point
 
 
 
+//the output delivered to g_trace, f_ret only sets the return value if all three calls of g were traced.
+std::vector<std::string> traced;
+
+struct g_trace : trace_point
+{
+    g_trace() : trace_point("g", "i=%d", {"i"})
+    {
+    }
+
+    void trace(const std::string & text) override
+    {
+        std::cerr << "g(" << text << ")" << std::endl;
+        traced.push_back(text);
+    }
+};
+
 struct f_ret : break_point
 {
     f_ret() : break_point("f()")
@@ -49,6 +152,8 @@ struct f_ret : break_point
     void invoke(frame & fr, const std::string & file, int line) override
     {
         std::cerr << file << "(" << line << "): " << "f()" << std::endl;
+        if (traced != std::vector<std::string>{"i=0", "i=1", "i=2"})
+            return;
         fr.return_("42");
     }
 };
@@ -57,6 +162,10 @@ void mw_dbg_setup_bps(std::vector<std::unique_ptr<mw::debug::break_point>> & bps
 {
     bps.push_back(std::make_unique<f_ptr>());
     bps.push_back(std::make_unique<f_ref>());
+    bps.push_back(std::make_unique<h_cache>());
+    bps.push_back(std::make_unique<w_failed>());
+    bps.push_back(std::make_unique<s_shadow>());
+    bps.push_back(std::make_unique<g_trace>());
     bps.push_back(std::make_unique<f_ret>());
 };
 
@@ -22,6 +22,11 @@ void f(int * p)
 
 int f() {return 0;}
 
+void g(int i) {}
+void h(int * p) {}
+void w(int * p) {}
+void s(int & ok) {}
+
 int main(int argc, char * argv[])
 {
     int value = 0;
@@ -39,9 +44,30 @@ int main(int argc, char * argv[])
     if (arr[1] != 2) error |= 0b00100;
     if (arr[2] != 3) error |= 0b01000;
 
+    for (int i = 0; i < 3; i++)
+        g(i);
+
     if (f() != 42)
         error |= 0b10000;
 
+    int cached[2] = {0, 0};
+    h(static_cast<int*>(cached));
+
+    if ((cached[0] != 1) || (cached[1] != 2))
+        error |= 0b100000;
+
+    int written[2] = {0, 0};
+    w(static_cast<int*>(written));
+
+    if ((written[0] != 1) || (written[1] != 2))
+        error |= 0b1000000;
+
+    int shadowed = 0;
+    s(shadowed);
+
+    if (shadowed != 1)
+        error |= 0b10000000;
+
     return error;
 }
 
@@ -120,10 +120,10 @@ int main(int argc, char * argv[])
         auto ret = bp::system(exe,  "--exe=" + target.string(), "--debug", "--timeout=5", source_dir);
         cerr << "\n-------------------------------------------------------------------------------\n" << endl;
 
-        BOOST_TEST(ret == 0b11111);
-        if (ret != 0b11111)
+        BOOST_TEST(ret == 0b11111111);
+        if (ret != 0b11111111)
         {
-            std::cerr << "Return value Error [" << ret << " != " << 0b11111 << "]" << std::endl;
+            std::cerr << "Return value Error [" << ret << " != " << 0b11111111 << "]" << std::endl;
         }
     }
     {
@@ -0,0 +1,108 @@
+/**
+ * @file   /gdb-runner/test/trace_filter.cpp
+ * @date   16.10.2026
+ * @author Klemens D. Morgenstern
+ *
+ * Published under [Apache License 2.0](http://www.apache.org/licenses/LICENSE-2.0.html)
+  <pre>
+    /  /|  (  )   |  |  /
+   /| / |   \/    | /| /
+  / |/  |   /\    |/ |/
+ /  /   |  (  \   /  |
+               ) 
+</pre>
+ */
+
+#include <mw/gdb/trace_filter.hpp>
+
+#define BOOST_TEST_MODULE trace_filter_test
+#define BOOST_TEST_NO_LIB
+
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace mw::gdb;
+
+using trace_list = std::vector<std::pair<std::size_t, std::string>>;
+
+struct collect
+{
+    trace_list & traces;
+    void operator()(std::size_t idx, const std::string & text) {traces.emplace_back(idx, text);}
+};
+
+BOOST_AUTO_TEST_CASE(tag_and_index)
+{
+    trace_filter tf{"mw-trace "};
+    trace_list traces;
+
+    tf.feed("mw-trace 0:fd=1 len=12\n", 2, collect{traces});
+    tf.feed("mw-trace 1:\n", 2, collect{traces});
+    tf.feed("mw-trace 1:a:b\nmw-trace 0:x\n", 2, collect{traces});
+
+    BOOST_REQUIRE_EQUAL(traces.size(), 4u);
+    BOOST_CHECK_EQUAL(traces[0].first, 0u);
+    BOOST_CHECK_EQUAL(traces[0].second, "fd=1 len=12");
+    BOOST_CHECK_EQUAL(traces[1].first, 1u);
+    BOOST_CHECK_EQUAL(traces[1].second, "");
+    BOOST_CHECK_EQUAL(traces[2].first, 1u);
+    BOOST_CHECK_EQUAL(traces[2].second, "a:b");
+    BOOST_CHECK_EQUAL(traces[3].first, 0u);
+    BOOST_CHECK_EQUAL(traces[3].second, "x");
+}
+
+BOOST_AUTO_TEST_CASE(split_records)
+{
+    trace_filter tf{"mw-trace "};
+    trace_list traces;
+
+    tf.feed("mw-tr", 1, collect{traces});
+    tf.feed("ace ", 1, collect{traces});
+    tf.feed("0:i=", 1, collect{traces});
+    BOOST_CHECK(traces.empty());
+    tf.feed("42\nmw-trace 0:", 1, collect{traces});
+    BOOST_REQUIRE_EQUAL(traces.size(), 1u);
+    BOOST_CHECK_EQUAL(traces[0].second, "i=42");
+
+    tf.feed("i=43", 1, collect{traces});
+    BOOST_CHECK_EQUAL(traces.size(), 1u);
+    tf.feed("\n", 1, collect{traces});
+    BOOST_REQUIRE_EQUAL(traces.size(), 2u);
+    BOOST_CHECK_EQUAL(traces[1].first, 0u);
+    BOOST_CHECK_EQUAL(traces[1].second, "i=43");
+}
+
+BOOST_AUTO_TEST_CASE(other_output)
+{
+    trace_filter tf{"mw-trace "};
+    trace_list traces;
+
+    tf.feed("Hello from the target\n", 1, collect{traces});
+    BOOST_CHECK(traces.empty());
+
+    tf.feed("no newline here", 1, collect{traces});
+    tf.feed("mw-trace 0:after\n", 1, collect{traces});
+    BOOST_REQUIRE_EQUAL(traces.size(), 1u);
+    BOOST_CHECK_EQUAL(traces[0].second, "after");
+}
+
+BOOST_AUTO_TEST_CASE(malformed)
+{
+    trace_filter tf{"mw-trace "};
+    trace_list traces;
+
+    tf.feed("mw-trace 2:out of range\n", 2, collect{traces});
+    tf.feed("mw-trace 1:no trace points\n", 0, collect{traces});
+    tf.feed("mw-trace 0 no colon\n", 2, collect{traces});
+    tf.feed("mw-trace x:not a number\n", 2, collect{traces});
+    tf.feed("mw-trace 1x:trailing garbage\n", 2, collect{traces});
+    tf.feed("mw-trace 99999999999999999999999:overflow\n", 2, collect{traces});
+    BOOST_CHECK(traces.empty());
+
+    tf.feed("mw-trace 1:valid\n", 2, collect{traces});
+    BOOST_REQUIRE_EQUAL(traces.size(), 1u);
+    BOOST_CHECK_EQUAL(traces[0].first, 1u);
+    BOOST_CHECK_EQUAL(traces[0].second, "valid");
+}